@@ -0,0 +1,42 @@
+#include "benchmarking.hpp"
+
+#include "../useful/aligned.hpp"
+
+using namespace uf;
+
+namespace
+{
+    // The same loop over a plain span, which needs a peel and a tail, and over the padded aligned buffer
+    __attribute__((noinline)) u32 sum_span(span<const u32> s)
+    {
+        u32 sum = 0;
+        for (u64 i = 0; i < s.size(); ++i)
+            sum += s[i] * 3 + 1;
+        return sum;
+    }
+
+    // Whole vectors only: the inner loop has a constant trip count and there is no tail to handle
+    __attribute__((noinline)) u32 sum_padded(aligned_span<const u32, 64> s)
+    {
+        constexpr u64 lanes = aligned_span<const u32, 64>::vector_size;
+        u32 sum = 0;
+        for (u64 i = 0; i < s.size(); i += lanes)
+            for (u64 j = 0; j < lanes; ++j)
+                sum += s[i + j] * 3 + 1;
+        return sum;
+    }
+}
+
+BENCH(aligned_buffer)
+{
+    // Many short arrays, where the tail is a large share of the work
+    constexpr u64 n = 37;
+    std::vector<u32> plain(n + 1);
+    aligned_buffer<u32, 64> buffer(n);
+    for (u64 i = 0; i < n; ++i)
+        plain[i + 1] = buffer[i] = static_cast<u32>(i);
+
+    report("span, unaligned start", n * sizeof(u32), [&]() { keep(sum_span(span<const u32>(plain.data() + 1, n))); });
+    // Padding elements are zero and add 1 each, taken back after the loop
+    report("aligned_buffer, padded", n * sizeof(u32), [&]() { keep(sum_padded(buffer.padded()) - u32(buffer.padded_size() - n)); });
+}
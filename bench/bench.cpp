@@ -0,0 +1,28 @@
+#include <iostream>
+#include <map>
+#include <string>
+#include <functional>
+
+
+std::multimap<std::string, std::function<void()>>& get_bench_map() noexcept
+{
+    static std::multimap<std::string, std::function<void()>> result;
+    return result;
+}
+
+// Runs every benchmark, or only the ones named on the command line
+int main(int argc, char** argv)
+{
+    for (auto& [name, func] : get_bench_map())
+    {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i)
+            selected = selected || name == argv[i];
+        if (!selected)
+            continue;
+        std::cout << "[" << name << "]" << std::endl;
+        func();
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <map>
+#include <string>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+
+#include "../useful/benchmark.hpp"
+
+using std::cout;
+using std::endl;
+
+std::multimap<std::string, std::function<void()>>& get_bench_map() noexcept;
+
+// Keeps the optimizer from dropping a result that is otherwise unused
+template<typename Tp>
+inline void keep(const Tp& value)
+{
+    __asm__ __volatile__("" : : "g"(&value) : "memory");
+}
+
+// Prints the best throughput of several runs of f over the given number of bytes
+template<typename F>
+void report(const std::string& what, uf::u64 bytes, F&& f)
+{
+    uf::u64 best = std::numeric_limits<uf::u64>::max();
+    for (int i = 0; i < 20; ++i)
+        best = std::min(best, uf::cycle_benchmark(f));
+    cout << std::setw(32) << std::left << what << std::fixed << std::setprecision(3) << static_cast<double>(bytes) / best << " bytes/cycle" << endl;
+}
+
+// Same as report, in megabytes per second of wall time, for benchmarks that touch files
+template<typename F>
+void report_mbps(const std::string& what, uf::u64 bytes, F&& f)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < 5; ++i)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        f();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count());
+    }
+    cout << std::setw(32) << std::left << what << std::fixed << std::setprecision(1) << bytes / best / 1e6 << " MB/s" << endl;
+}
+
+#define BENCH(name) \
+    static void uf_bench_##name(); \
+    static int DUMMY_##name = []() noexcept { get_bench_map().insert({#name, &uf_bench_##name}); return 0; }(); \
+    static void uf_bench_##name()
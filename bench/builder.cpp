@@ -0,0 +1,53 @@
+#include "benchmarking.hpp"
+
+#include "../useful/builder.hpp"
+
+using namespace uf;
+
+BENCH(string_builder)
+{
+    // A few MB of small pieces, like a large JSON response
+    constexpr u64 rows = 100000;
+    const std::string_view name = "\"name\":\"some value\"";
+    std::string sample;
+    for (u64 i = 0; i < rows; ++i)
+        append_to(sample, "{\"id\":", i, ',', name, ",\"score\":", i * 7 % 1000, "},\n");
+
+    report("std::string +=", sample.size(), [&]()
+    {
+        std::string s;
+        for (u64 i = 0; i < rows; ++i)
+        {
+            s += "{\"id\":";
+            s += std::to_string(i);
+            s += ',';
+            s += name;
+            s += ",\"score\":";
+            s += std::to_string(i * 7 % 1000);
+            s += "},\n";
+        }
+        keep(s.size());
+    });
+    report("append_to", sample.size(), [&]()
+    {
+        std::string s;
+        for (u64 i = 0; i < rows; ++i)
+            append_to(s, "{\"id\":", i, ',', name, ",\"score\":", i * 7 % 1000, "},\n");
+        keep(s.size());
+    });
+    chunk_pool pool;
+    report("string_builder pooled", sample.size(), [&]()
+    {
+        string_builder b(pool);
+        for (u64 i = 0; i < rows; ++i)
+            b.append("{\"id\":", i, ',', name, ",\"score\":", i * 7 % 1000, "},\n");
+        keep(b.pieces().size());
+    });
+    report("string_builder + str()", sample.size(), [&]()
+    {
+        string_builder b(pool);
+        for (u64 i = 0; i < rows; ++i)
+            b.append("{\"id\":", i, ',', name, ",\"score\":", i * 7 % 1000, "},\n");
+        keep(b.str().size());
+    });
+}
@@ -0,0 +1,96 @@
+#include "benchmarking.hpp"
+
+#include "../useful/bytes.hpp"
+
+#include <random>
+
+using namespace uf;
+
+BENCH(byte_reader)
+{
+    // Records of a u32 id, a big-endian u16 tag, an f64 value and a varint count
+    std::mt19937 rng(9);
+    constexpr u64 records = 100000;
+    std::vector<std::byte> buffer(records * 24);
+    byte_writer w{span<std::byte>(buffer)};
+    for (u64 i = 0; i < records; ++i)
+    {
+        w.write_fields(u32(rng()), u16(rng()), double(i));
+        w.write_be<u16>(u16(rng()));
+        w.write_varint(rng() % 1000);
+    }
+    const u64 size = w.position();
+
+    report("memcpy by hand", size, [&]()
+    {
+        const std::byte* p = buffer.data();
+        const std::byte* end = p + size;
+        u64 sum = 0;
+        while (p != end)
+        {
+            u32 id;
+            u16 tag, be;
+            double value;
+            std::memcpy(&id, p, 4);
+            std::memcpy(&tag, p + 4, 2);
+            std::memcpy(&value, p + 6, 8);
+            std::memcpy(&be, p + 14, 2);
+            p += 16;
+            u64 count = 0;
+            for (u64 shift = 0;; shift += 7)
+            {
+                const u8 b = static_cast<u8>(*p++);
+                count |= u64(b & 0x7f) << shift;
+                if (b < 0x80)
+                    break;
+            }
+            sum += id + tag + static_cast<u64>(value) + __builtin_bswap16(be) + count;
+        }
+        keep(sum);
+    });
+    report("byte_reader read", size, [&]()
+    {
+        byte_reader r(span<const std::byte>(buffer.data(), size));
+        u64 sum = 0;
+        while (!r.empty())
+        {
+            sum += r.read<u32>();
+            sum += r.read<u16>();
+            sum += static_cast<u64>(r.read<double>());
+            sum += r.read_be<u16>();
+            sum += r.read_varint();
+        }
+        keep(sum);
+    });
+    report("byte_reader read_fields", size, [&]()
+    {
+        byte_reader r(span<const std::byte>(buffer.data(), size));
+        u64 sum = 0;
+        while (!r.empty())
+        {
+            u32 id;
+            u16 tag;
+            double value;
+            r.read_fields(id, tag, value);
+            sum += id + tag + static_cast<u64>(value);
+            sum += r.read_be<u16>();
+            sum += r.read_varint();
+        }
+        keep(sum);
+    });
+    report("byte_reader unchecked", size, [&]()
+    {
+        byte_reader r(span<const std::byte>(buffer.data(), size));
+        u64 sum = 0;
+        while (!r.empty())
+        {
+            r.require(16);
+            sum += r.read_unchecked<u32>();
+            sum += r.read_unchecked<u16>();
+            sum += static_cast<u64>(r.read_unchecked<double>());
+            sum += r.read_unchecked<u16, byte_order::big>();
+            sum += r.read_varint();
+        }
+        keep(sum);
+    });
+}
@@ -0,0 +1,51 @@
+#include "benchmarking.hpp"
+
+#include "../useful/chunks.hpp"
+
+using namespace uf;
+
+BENCH(chunks_exact)
+{
+    // Per-block checksums of 16-element blocks, as in fixed-size record or key processing
+    std::vector<u32> data(1 << 16);
+    for (u64 i = 0; i < data.size(); ++i)
+        data[i] = static_cast<u32>(i * 2654435761u);
+    const u64 bytes = data.size() * sizeof(u32);
+
+    report("raw index loop", bytes, [&]()
+    {
+        u32 total = 0;
+        for (u64 b = 0; b + 16 <= data.size(); b += 16)
+        {
+            u32 x = 0;
+            for (u64 i = 0; i < 16; ++i)
+                x ^= data[b + i] * 31;
+            total += x;
+        }
+        keep(total);
+    });
+    report("chunks_exact(16)", bytes, [&]()
+    {
+        u32 total = 0;
+        for (auto block : chunks_exact(data, 16))
+        {
+            u32 x = 0;
+            for (u32 v : block)
+                x ^= v * 31;
+            total += x;
+        }
+        keep(total);
+    });
+    report("chunks_exact<16>", bytes, [&]()
+    {
+        u32 total = 0;
+        for (auto block : chunks_exact<16>(data))
+        {
+            u32 x = 0;
+            for (u32 v : block)
+                x ^= v * 31;
+            total += x;
+        }
+        keep(total);
+    });
+}
@@ -0,0 +1,80 @@
+#include "benchmarking.hpp"
+
+#include "../useful/convert.hpp"
+#include "../useful/strings.hpp"
+
+#include <random>
+#include <sstream>
+
+using namespace uf;
+
+BENCH(parse)
+{
+    std::mt19937 rng(7);
+    std::string text;
+    for (int i = 0; i < 100000; ++i)
+        text += std::to_string(rng() % 1000000000) + ',';
+    const auto tokens = split(text, ',');
+
+    report("std::stoi", text.size(), [&]()
+    {
+        u64 sum = 0;
+        for (const auto& t : tokens)
+            sum += std::stoi(t);
+        keep(sum);
+    });
+    report("std::istringstream", text.size(), [&]()
+    {
+        u64 sum = 0;
+        for (const auto& t : tokens)
+        {
+            std::istringstream in(t);
+            int value;
+            in >> value;
+            sum += value;
+        }
+        keep(sum);
+    });
+    std::vector<int> column;
+    report("uf::parse_into", text.size(), [&]()
+    {
+        column.clear();
+        keep(parse_into(tokens, column));
+    });
+
+    // Fixed-width column: 12 digit fields
+    std::string fixed;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const std::string digits = std::to_string(u64(rng() % 1000000) * 1000000 + rng() % 1000000);
+        fixed += std::string(12 - digits.size(), '0') + digits;
+    }
+    std::vector<u64> values;
+    for (auto l : {simd::level::scalar, simd::level::avx2})
+    {
+        simd::limit(l);
+        report(l == simd::level::scalar ? "uf::parse_fixed_into scalar" : "uf::parse_fixed_into avx2", fixed.size(), [&]()
+        {
+            values.clear();
+            keep(parse_fixed_into(fixed, 12, values));
+        });
+    }
+    simd::limit(simd::supported());
+
+    simd::limit(simd::level::scalar);
+    report("uf::parse_fixed view scalar", fixed.size(), [&]()
+    {
+        u64 sum = 0, value = 0;
+        for (u64 i = 0; i + 12 <= fixed.size(); i += 12)
+            sum += parse_fixed(std::string_view(fixed.data() + i, 12), value) == std::errc() ? value : 0;
+        keep(sum);
+    });
+    report("uf::parse_fixed span<12> scalar", fixed.size(), [&]()
+    {
+        u64 sum = 0, value = 0;
+        for (u64 i = 0; i + 12 <= fixed.size(); i += 12)
+            sum += parse_fixed(span<const char, 12>(fixed.data() + i), value) == std::errc() ? value : 0;
+        keep(sum);
+    });
+    simd::limit(simd::supported());
+}
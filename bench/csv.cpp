@@ -0,0 +1,45 @@
+#include "benchmarking.hpp"
+
+#include "../useful/csv.hpp"
+#include "../useful/strings.hpp"
+
+#include <cstdio>
+#include <random>
+
+using namespace uf;
+
+BENCH(csv_reader)
+{
+    const std::string path = "uf_bench.csv";
+    std::mt19937 rng(7);
+    u64 size = 0;
+    {
+        std::ofstream out(path);
+        std::string line;
+        for (int i = 0; i < 1000000; ++i)
+        {
+            line = std::to_string(rng()) + ",2019-05-14 12:00:01,Worker-" + std::to_string(rng() % 32) + ",GET /api/users," + std::to_string(rng() % 1000) + "\n";
+            size += line.size();
+            out << line;
+        }
+    }
+
+    report_mbps("std::getline + uf::split", size, [&]()
+    {
+        std::ifstream in(path);
+        std::string line;
+        u64 fields = 0;
+        while (std::getline(in, line))
+            fields += split(line, ',').size();
+        keep(fields);
+    });
+    report_mbps("uf::csv_reader", size, [&]()
+    {
+        csv_reader reader(path);
+        u64 fields = 0;
+        for (const auto& row : reader)
+            fields += row.size();
+        keep(fields);
+    });
+    std::remove(path.c_str());
+}
@@ -0,0 +1,28 @@
+#include "benchmarking.hpp"
+
+#include "../useful/encoding.hpp"
+
+#include <random>
+
+using namespace uf;
+
+BENCH(encoding)
+{
+    std::mt19937 rng(7);
+    std::vector<std::byte> data(1 << 20);
+    for (auto& b : data)
+        b = static_cast<std::byte>(rng());
+    std::string hex(hex_encoded_size(data.size()), '\0'), base64(base64_encoded_size(data.size()), '\0');
+    std::vector<std::byte> back(data.size());
+
+    for (int l = 0; l <= static_cast<int>(simd::supported()); ++l)
+    {
+        simd::limit(static_cast<simd::level>(l));
+        const std::string suffix = l == 0 ? " scalar" : l == 1 ? " sse2" : l == 2 ? " avx2" : " avx512";
+        report("hex_encode" + suffix, data.size(), [&]() { keep(hex_encode(data, span<char>(hex))); });
+        report("hex_decode" + suffix, data.size(), [&]() { keep(hex_decode(span<const char>(hex), span<std::byte>(back))); });
+        report("base64_encode" + suffix, data.size(), [&]() { keep(base64_encode(data, span<char>(base64))); });
+        report("base64_decode" + suffix, data.size(), [&]() { keep(base64_decode(span<const char>(base64), span<std::byte>(back))); });
+    }
+    simd::limit(simd::supported());
+}
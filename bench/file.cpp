@@ -0,0 +1,64 @@
+#include "benchmarking.hpp"
+
+#include "../useful/file.hpp"
+
+#include <cstdio>
+#include <random>
+#include <thread>
+
+using namespace uf;
+
+BENCH(mapped_lines)
+{
+    const std::string path = "uf_bench.log";
+    std::mt19937 rng(7);
+    u64 size = 0;
+    {
+        std::ofstream out(path);
+        std::string line;
+        for (int i = 0; i < 1000000; ++i)
+        {
+            line = "2019-05-14 12:00:01 worker-" + std::to_string(rng() % 32) + " GET /api/users/" + std::to_string(rng()) + " 200\n";
+            size += line.size();
+            out << line;
+        }
+    }
+
+    report_mbps("std::getline", size, [&]()
+    {
+        std::ifstream in(path);
+        std::string line;
+        u64 chars = 0;
+        while (std::getline(in, line))
+            chars += line.size();
+        keep(chars);
+    });
+    report_mbps("mapped_lines mmap", size, [&]()
+    {
+        u64 chars = 0;
+        for (std::string_view line : mapped_lines(path))
+            chars += line.size();
+        keep(chars);
+    });
+    std::string text(size, 0);
+    std::ifstream(path).read(text.data(), size);
+    report_mbps("mapped_lines pipe", size, [&]()
+    {
+        int fds[2];
+        if (pipe(fds))
+            return;
+        std::thread writer([&]()
+        {
+            for (u64 i = 0; i < text.size();)
+                i += std::max<ssize_t>(0, write(fds[1], text.data() + i, text.size() - i));
+            close(fds[1]);
+        });
+        u64 chars = 0;
+        for (std::string_view line : mapped_lines(input_source(fds[0])))
+            chars += line.size();
+        keep(chars);
+        writer.join();
+        close(fds[0]);
+    });
+    std::remove(path.c_str());
+}
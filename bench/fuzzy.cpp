@@ -0,0 +1,73 @@
+#include "benchmarking.hpp"
+
+#include "../useful/fuzzy.hpp"
+
+#include <random>
+
+using namespace uf;
+
+namespace
+{
+    u64 dp_levenshtein(std::string_view a, std::string_view b)
+    {
+        std::vector<std::vector<u64>> d(a.size() + 1, std::vector<u64>(b.size() + 1));
+        for (u64 i = 0; i <= a.size(); ++i)
+            d[i][0] = i;
+        for (u64 j = 0; j <= b.size(); ++j)
+            d[0][j] = j;
+        for (u64 i = 1; i <= a.size(); ++i)
+            for (u64 j = 1; j <= b.size(); ++j)
+                d[i][j] = std::min({d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (a[i - 1] != b[j - 1])});
+        return d[a.size()][b.size()];
+    }
+}
+
+BENCH(levenshtein)
+{
+    std::mt19937 rng(3);
+    const char* first[] = {"Jonathan", "Maria", "Alexander", "Elizabeth", "Mohammed", "Sofia"};
+    const char* last[] = {"Smith", "Garcia", "Ivanov", "Nakamura", "Okafor", "Schmidt-Weber"};
+    std::vector<std::string> names;
+    u64 bytes = 0;
+    for (int i = 0; i < 2000; ++i)
+    {
+        names.push_back(std::string(first[rng() % 6]) + " " + last[rng() % 6] + " " + std::to_string(rng() % 100));
+        bytes += names.back().size();
+    }
+    const std::string query = "Alexandr Nakamura 42";
+
+    report("dp matrix", bytes, [&]()
+    {
+        u64 total = 0;
+        for (const auto& n : names)
+            total += dp_levenshtein(query, n);
+        keep(total);
+    });
+    report("levenshtein", bytes, [&]()
+    {
+        u64 total = 0;
+        for (const auto& n : names)
+            total += levenshtein(query, n);
+        keep(total);
+    });
+    report("bounded_levenshtein k=2", bytes, [&]()
+    {
+        u64 total = 0;
+        for (const auto& n : names)
+            total += bounded_levenshtein(query, n, 2);
+        keep(total);
+    });
+    report("bounded_levenshtein_batch k=2", bytes, [&]()
+    {
+        keep(bounded_levenshtein_batch(query, names, 2));
+    });
+
+    std::string long_a(2000, 'a'), long_b;
+    for (auto& c : long_a)
+        c = 'a' + rng() % 20;
+    long_b = long_a;
+    for (int i = 0; i < 50; ++i)
+        long_b[rng() % long_b.size()] = 'z';
+    report("levenshtein 2000 chars", long_a.size(), [&]() { keep(levenshtein(long_a, long_b)); });
+    report("bounded 2000 chars k=10", long_a.size(), [&]() { keep(bounded_levenshtein(long_a, long_b, 10)); });
+}
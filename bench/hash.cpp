@@ -0,0 +1,62 @@
+#include "benchmarking.hpp"
+
+#include "../useful/hash.hpp"
+
+#include <random>
+#include <unordered_map>
+
+using namespace uf;
+
+BENCH(hash)
+{
+    std::mt19937 rng(5);
+    for (u64 n : {8, 16, 40, 256, 4096})
+    {
+        std::string data(n * 64, 'x');
+        for (auto& c : data)
+            c = static_cast<char>(rng());
+        const std::string_view view = data;
+        report("std::hash " + std::to_string(n), data.size(), [&]()
+        {
+            u64 h = 0;
+            for (u64 i = 0; i < data.size(); i += n)
+                h += std::hash<std::string_view>()(view.substr(i, n));
+            keep(h);
+        });
+        report("hash_string " + std::to_string(n), data.size(), [&]()
+        {
+            u64 h = 0;
+            for (u64 i = 0; i < data.size(); i += n)
+                h += hash_string(view.substr(i, n));
+            keep(h);
+        });
+    }
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 100000; ++i)
+        keys.push_back("worker-" + std::to_string(rng() % 50000) + ".example.org");
+    u64 bytes = 0;
+    for (const auto& k : keys)
+        bytes += k.size();
+    std::unordered_map<std::string_view, u64> std_map;
+    std::unordered_map<std::string_view, u64, hash, equal_to> uf_map;
+    for (const auto& k : keys)
+    {
+        ++std_map[k];
+        ++uf_map[k];
+    }
+    report("lookup std::hash", bytes, [&]()
+    {
+        u64 total = 0;
+        for (const auto& k : keys)
+            total += std_map.find(k)->second;
+        keep(total);
+    });
+    report("lookup uf::hash", bytes, [&]()
+    {
+        u64 total = 0;
+        for (const auto& k : keys)
+            total += uf_map.find(k)->second;
+        keep(total);
+    });
+}
@@ -0,0 +1,50 @@
+#include "benchmarking.hpp"
+
+#include "../useful/mdspan.hpp"
+
+using namespace uf;
+
+BENCH(mdspan)
+{
+    // Column scans of a 4096 x 4096 float matrix: every step of a row-major scan lands on a new page
+    constexpr u64 n = 4096;
+    std::vector<float> flat(n * n, 1.0f);
+    mdspan<float, extents<n, n>> rows(flat.data());
+    using tiled_view = mdspan<float, extents<n, n>, layout_tiled<64, 64>>;
+    std::vector<float> tiles(tiled_view::mapping_type().required_span_size());
+    tiled_view tiled(tiles.data());
+    copy(rows, tiled);
+
+    report("row-major, row order", n * n * sizeof(float), [&]()
+    {
+        float sum = 0;
+        for (u64 i = 0; i < n; ++i)
+            for (u64 j = 0; j < n; ++j)
+                sum += rows(i, j);
+        keep(sum);
+    });
+    report("row-major, column order", n * n * sizeof(float), [&]()
+    {
+        float sum = 0;
+        for (u64 j = 0; j < n; ++j)
+            for (u64 i = 0; i < n; ++i)
+                sum += rows(i, j);
+        keep(sum);
+    });
+    report("tiled 64x64, column order", n * n * sizeof(float), [&]()
+    {
+        float sum = 0;
+        for (u64 j = 0; j < n; ++j)
+            for (u64 i = 0; i < n; ++i)
+                sum += tiled(i, j);
+        keep(sum);
+    });
+    report("raw index, column order", n * n * sizeof(float), [&]()
+    {
+        float sum = 0;
+        for (u64 j = 0; j < n; ++j)
+            for (u64 i = 0; i < n; ++i)
+                sum += flat[i * n + j];
+        keep(sum);
+    });
+}
@@ -0,0 +1,35 @@
+#include "benchmarking.hpp"
+
+#include "../useful/pool.hpp"
+
+#include <random>
+
+using namespace uf;
+
+BENCH(string_pool)
+{
+    std::mt19937 rng(7);
+    const char* methods[] = {"GET", "POST", "PUT", "DELETE"};
+    std::string text;
+    for (int i = 0; i < 200000; ++i)
+        text += std::string("worker-") + std::to_string(rng() % 64) + ".example.org " + methods[rng() % 4] + " /api/v2/users\n";
+
+    report("split", text.size(), [&]()
+    {
+        keep(split(text, ' ', '\n'));
+    });
+    report("split_symbols", text.size(), [&]()
+    {
+        string_pool pool;
+        keep(split_symbols(pool, text, ' ', '\n'));
+    });
+
+    const auto tokens = split(text, ' ', '\n');
+    u64 strings = tokens.capacity() * sizeof(std::string);
+    for (const auto& t : tokens)
+        strings += t.capacity() > 15 ? t.capacity() + 1 : 0;
+    string_pool pool;
+    const auto symbols = split_symbols(pool, text, ' ', '\n');
+    cout << "std::vector<std::string>        " << strings << " bytes" << endl;
+    cout << "symbols + string_pool           " << symbols.capacity() * sizeof(string_pool::symbol) + pool.memory() << " bytes" << endl;
+}
@@ -0,0 +1,74 @@
+#include "benchmarking.hpp"
+
+#include "../useful/search.hpp"
+#include "../useful/matcher.hpp"
+
+#include <random>
+
+using namespace uf;
+
+BENCH(find)
+{
+    std::mt19937 rng(7);
+    std::string haystack(u64(1) << 22, ' ');
+    for (auto& c : haystack)
+        c = "abcdefghijklmnopqrstuvwxyz  \n"[rng() % 29];
+
+    for (u64 k : {4, 16, 64})
+    {
+        // Frequent letters with the last one changed, so candidates are common but never match
+        std::string needle = haystack.substr(haystack.size() / 2, k);
+        needle.back() = 'Q';
+        cout << "needle length = " << k << endl;
+
+        report("std::string_view::find", haystack.size(), [&]()
+        {
+            keep(std::string_view(haystack).find(needle));
+        });
+        report("std::boyer_moore_horspool", haystack.size(), [&]()
+        {
+            keep(std::search(haystack.begin(), haystack.end(), std::boyer_moore_horspool_searcher(needle.begin(), needle.end())));
+        });
+        report("uf::find", haystack.size(), [&]()
+        {
+            keep(uf::find(haystack, needle));
+        });
+        const searcher compiled(needle);
+        report("uf::searcher", haystack.size(), [&]()
+        {
+            keep(compiled.find(haystack));
+        });
+    }
+}
+
+BENCH(multi_matcher)
+{
+    std::mt19937 rng(7);
+    std::string haystack(u64(1) << 20, ' ');
+    for (auto& c : haystack)
+        c = "abcdefghijklmnopqrstuvwxyz  \n"[rng() % 29];
+
+    for (u64 count : {10, 1000})
+    {
+        std::vector<std::string> keywords(count);
+        for (auto& k : keywords)
+            for (u64 i = 0, length = 5 + rng() % 6; i < length; ++i)
+                k += "abcdefghijklmnopqrstuvwxyz"[rng() % 26];
+        cout << "keywords = " << count << endl;
+
+        report("uf::find per keyword", haystack.size(), [&]()
+        {
+            u64 found = 0;
+            for (const auto& k : keywords)
+                found += uf::find(haystack, k) != std::string_view::npos;
+            keep(found);
+        });
+        const multi_matcher matcher(keywords);
+        report("uf::multi_matcher", haystack.size(), [&]()
+        {
+            u64 found = 0;
+            matcher.for_each_match(span<const char>(haystack.data(), haystack.size()), [&found](const auto&){ ++found; });
+            keep(found);
+        });
+    }
+}
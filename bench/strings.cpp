@@ -0,0 +1,183 @@
+#include "benchmarking.hpp"
+
+#include "../useful/strings.hpp"
+
+#include <cctype>
+
+using namespace uf;
+
+namespace
+{
+    std::string make_log_text(u64 size)
+    {
+        static const std::string line = "2019-05-14 12:00:01 INFO  [Worker-7] GET /Api/V2/Users?Id=42 -> 200 OK (Cache MISS)\n";
+        std::string result;
+        result.reserve(size);
+        while (result.size() < size)
+            result += line;
+        result.resize(size);
+        return result;
+    }
+}
+
+BENCH(lowercase)
+{
+    const char* names[] = {"scalar", "sse2", "avx2", "avx512"};
+    for (u64 size : {u64(64), u64(4096), u64(1) << 20})
+    {
+        cout << "size = " << size << endl;
+        std::string text = make_log_text(size);
+
+        report("std::tolower loop", size, [&]()
+        {
+            for (auto& c : text)
+                c = std::tolower(c);
+            keep(text);
+        });
+
+        for (int l = 0; l <= static_cast<int>(simd::supported()); ++l)
+        {
+            simd::limit(static_cast<simd::level>(l));
+            report(std::string("lowercase, ") + names[l], size, [&]()
+            {
+                lowercase(span<char>(text));
+                keep(text);
+            });
+        }
+        simd::limit(simd::supported());
+    }
+}
+
+BENCH(split_itr)
+{
+    std::string tsv;
+    while (tsv.size() < (u64(1) << 22))
+        tsv += "1024\tGET\t/api/v2/users\t200\t0.0042\tMozilla/5.0\n";
+
+    report("predicate delimiters", tsv.size(), [&]()
+    {
+        keep(split_itr(tsv, [](char c){ return c == '\t'; }, [](char c){ return c == '\n'; }));
+    });
+    report("char delimiters", tsv.size(), [&]()
+    {
+        keep(split_itr(tsv, '\t', '\n'));
+    });
+    report("token scan only", tsv.size(), [&]()
+    {
+        u64 count = 0;
+        simd::for_each_token(tsv.data(), tsv.data() + tsv.size(), simd::byte_set('\t', '\n'), std::numeric_limits<u64>::max(), [&](const char*, const char*){ ++count; });
+        keep(count);
+    });
+}
+
+BENCH(parallel_split)
+{
+    std::string tsv;
+    while (tsv.size() < (u64(1) << 26))
+        tsv += "1024\tGET\t/api/v2/users\t200\t0.0042\tMozilla/5.0\n";
+
+    report_mbps("split_itr", tsv.size(), [&]()
+    {
+        keep(split_itr(tsv, '\t', '\n'));
+    });
+    cout << std::thread::hardware_concurrency() << " cores" << endl;
+    report_mbps("parallel_split", tsv.size(), [&]()
+    {
+        keep(parallel_split(tsv, 0, '\t', '\n'));
+    });
+    report_mbps("parallel_split_chunks", tsv.size(), [&]()
+    {
+        keep(parallel_split_chunks(tsv, 0, '\t', '\n'));
+    });
+}
+
+BENCH(iequals)
+{
+    std::vector<std::string> headers;
+    for (int i = 0; i < 1000; ++i)
+        headers.push_back(i % 2 ? "Content-Type: application/json; charset=utf-8" : "content-length: " + std::to_string(i * 37));
+    u64 bytes = 0;
+    for (const auto& h : headers)
+        bytes += h.size();
+    report("starts_with(lowercase(s))", bytes, [&]()
+    {
+        u64 count = 0;
+        for (const auto& h : headers)
+            count += starts_with(lowercase(h), "content-type:");
+        keep(count);
+    });
+    report("istarts_with", bytes, [&]()
+    {
+        u64 count = 0;
+        for (const auto& h : headers)
+            count += istarts_with(h, "content-type:");
+        keep(count);
+    });
+
+    const std::string text = make_log_text(1 << 20) + "needle in the Haystack";
+    report("lowercase + find", text.size(), [&]()
+    {
+        keep(lowercase(text).find("the haystack"));
+    });
+    report("ifind", text.size(), [&]()
+    {
+        keep(ifind(text, "the haystack"));
+    });
+}
+
+BENCH(concat)
+{
+    const std::string host = "worker-7.example.org";
+    const std::string path = "/api/v2/users";
+    const u64 bytes = concat(host, ':', 8080, ' ', path, " -> ", 200, ' ', 12.5).size();
+    report("operator+", bytes, [&]()
+    {
+        keep(host + ':' + std::to_string(8080) + ' ' + path + " -> " + std::to_string(200) + ' ' + std::to_string(12.5));
+    });
+    report("std::ostringstream", bytes, [&]()
+    {
+        std::ostringstream out;
+        out << host << ':' << 8080 << ' ' << path << " -> " << 200 << ' ' << 12.5;
+        keep(out.str());
+    });
+    report("uf::concat", bytes, [&]()
+    {
+        keep(concat(host, ':', 8080, ' ', path, " -> ", 200, ' ', 12.5));
+    });
+
+    const auto fields = split(make_log_text(u64(1) << 16), ' ');
+    const u64 joined = join(fields, ' ').size();
+    report("operator+= loop", joined, [&]()
+    {
+        std::string result;
+        for (const auto& f : fields)
+        {
+            if (!result.empty())
+                result += ' ';
+            result += f;
+        }
+        keep(result);
+    });
+    report("uf::join", joined, [&]()
+    {
+        keep(join(fields, ' '));
+    });
+}
+
+BENCH(strip)
+{
+    const std::string payload = "  " + make_log_text(4096) + "\n";
+    report("uf::strip", payload.size(), [&]()
+    {
+        keep(strip(payload, ' ', '\n'));
+    });
+    report("uf::strip_view", payload.size(), [&]()
+    {
+        keep(strip_view(payload, ' ', '\n'));
+    });
+    const std::string padded = std::string(4096, ' ') + "x" + std::string(4096, '\n');
+    report("uf::strip_view long runs", padded.size(), [&]()
+    {
+        keep(strip_view(padded, ' ', '\n'));
+    });
+}
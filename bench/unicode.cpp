@@ -0,0 +1,36 @@
+#include "benchmarking.hpp"
+
+#include "../useful/unicode.hpp"
+
+using namespace uf;
+
+BENCH(utf8_validate)
+{
+    std::string ascii, mixed;
+    while (mixed.size() < (u64(1) << 20))
+    {
+        ascii += "GET /Api/V2/Users?Id=42 -> 200 OK (Cache MISS)\n";
+        mixed += "\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 Welt \xe2\x82\xac 42 \xf0\x9f\x98\x80\n";
+    }
+    for (auto l : {simd::level::scalar, simd::level::avx2})
+    {
+        simd::limit(l);
+        const std::string suffix = l == simd::level::scalar ? " scalar" : " avx2";
+        report("ascii" + suffix, ascii.size(), [&]() { keep(utf8_validate(ascii)); });
+        report("mixed" + suffix, mixed.size(), [&]() { keep(utf8_validate(mixed)); });
+    }
+    simd::limit(simd::supported());
+}
+
+BENCH(casefold)
+{
+    std::string ascii, mixed;
+    while (mixed.size() < (u64(1) << 20))
+    {
+        ascii += "GET /Api/V2/Users?Id=42 -> 200 OK (Cache MISS)\n";
+        mixed += "GET /Api/V2/\xd0\x9f\xd0\xa0\xd0\x98\xd0\x92\xd0\x95\xd0\xa2?Id=42 -> 200 OK (Cache MISS)\n";
+    }
+    report("lowercase ascii", ascii.size(), [&]() { keep(lowercase(ascii)); });
+    report("casefold ascii", ascii.size(), [&]() { keep(casefold(ascii)); });
+    report("casefold mixed", mixed.size(), [&]() { keep(casefold(mixed)); });
+}
@@ -30,5 +30,41 @@ TEST(split)
     }
 }
 
+TEST(case_conversion)
+{
+    std::string bytes;
+    for (int i = 0; i < 300; ++i)
+        bytes.push_back(static_cast<char>(i));
 
+    for (auto l : {simd::level::scalar, simd::level::sse2, simd::level::avx2, simd::level::avx512})
+    {
+        simd::limit(l);
+        for (u64 offset = 0; offset < 3; ++offset)
+        {
+            for (u64 n = 0; offset + n <= bytes.size(); n += 13)
+            {
+                const std::string s = bytes.substr(offset, n);
+                const std::string lower = lowercase(s);
+                const std::string upper = uppercase(s);
+                assert_eq(lower.size(), n);
+                assert_eq(upper.size(), n);
+                for (u64 i = 0; i < n; ++i)
+                {
+                    assert_eq(lower[i], s[i] >= 'A' && s[i] <= 'Z' ? s[i] + 32 : s[i]);
+                    assert_eq(upper[i], s[i] >= 'a' && s[i] <= 'z' ? s[i] - 32 : s[i]);
+                }
 
+                std::string inplace = s;
+                lowercase(span<char>(inplace));
+                assert_eq(inplace, lower);
+                uppercase(span(inplace));
+                assert_eq(inplace, upper);
+                assert_eq(lowercase(std::string(s)), lower);
+            }
+        }
+    }
+    simd::limit(simd::supported());
+
+    assert_eq(lowercase("Hello, World!"), std::string("hello, world!"));
+    assert_eq(uppercase("Hello, World!"), std::string("HELLO, WORLD!"));
+}
@@ -1,7 +1,78 @@
 #include <iostream>
 #include <map>
 #include <functional>
+#include <cstdlib>
+#include <new>
 
+namespace
+{
+    thread_local unsigned long long allocations = 0;
+}
+
+// Every allocation is counted, so tests can check that a path does not allocate. All unaligned forms are
+// replaced so that allocation and deallocation always pair up, also under sanitizers.
+static void* counted_malloc(std::size_t size) noexcept
+{
+    ++allocations;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(std::size_t size)
+{
+    if (void* p = counted_malloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_malloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_malloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+unsigned long long allocation_count() noexcept
+{
+    return allocations;
+}
 
 std::multimap<std::string, std::function<void()>>& get_test_map() noexcept
 {
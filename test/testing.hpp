@@ -13,6 +13,9 @@ using std::endl;
 
 std::multimap<std::string, std::function<void()>>& get_test_map() noexcept;
 
+// Allocations made so far by the calling thread
+unsigned long long allocation_count() noexcept;
+
 #define TEST(name) \
     static void wh_test_##name(); \
     static int DUMMY_##name = []() noexcept { get_test_map().insert({#name, &wh_test_##name}); return 0; }(); \
@@ -0,0 +1,75 @@
+#include "testing.hpp"
+
+#include "../useful/aligned.hpp"
+
+using namespace uf;
+
+TEST(aligned_buffer)
+{
+    aligned_buffer<float, 32> empty;
+    assert_true(empty.empty());
+    assert_eq(empty.padded_size(), 0);
+    assert_eq(empty.view().size(), 0);
+
+    aligned_buffer<float, 32> b(11);
+    assert_eq(b.size(), 11);
+    assert_eq(b.padded_size(), 16);
+    static_assert (aligned_span<float, 32>::vector_size == 8);
+    assert_eq(reinterpret_cast<std::uintptr_t>(b.data()) % 32, 0);
+    assert_true(std::all_of(b.padded().begin(), b.padded().end(), [](float x) { return x == 0; }));
+    for (u64 i = 0; i < b.size(); ++i)
+        b[i] = static_cast<float>(i);
+
+    // Kernels may run over the padding, zeros keep sums intact
+    float sum = 0;
+    for (float x : b.padded())
+        sum += x;
+    assert_eq(sum, 55);
+    b.padded()[15] = 7;
+    b.clear_padding();
+    assert_eq(b.padded()[15], 0);
+
+    aligned_buffer<float, 32> copy = b;
+    assert_true(copy.data() != b.data());
+    assert_true(std::equal(copy.begin(), copy.end(), b.begin(), b.end()));
+    aligned_buffer<float, 32> moved = std::move(copy);
+    assert_true(copy.empty());
+    assert_eq(moved[10], 10);
+
+    const std::vector<u8> bytes{1, 2, 3};
+    aligned_buffer<u8, 64> from(bytes);
+    assert_eq(from.padded_size(), 64);
+    assert_eq(from[2], 3);
+    assert_eq(from.padded()[3], 0);
+
+    // Any aligned_span converts to a plain span and to weaker alignments of const
+    aligned_span<const float, 16> weaker = b.view();
+    assert_eq(weaker.size(), 11);
+    span<const float> plain = weaker.view();
+    assert_eq(plain[10], 10);
+    assert_eq(b.view().first(4).size(), 4);
+    assert_eq(b.view().first(40).size(), 11);
+}
+
+TEST(aligned_span)
+{
+    alignas(64) int storage[32] = {};
+    aligned_span<int, 64> s(storage, 32);
+    assert_eq(s.size(), 32);
+    assert_eq(s.data(), storage);
+    s[3] = 5;
+    assert_eq(storage[3], 5);
+    aligned_span<int, 16> inner(storage + 4, 4);
+    assert_eq(inner[0], 0);
+
+    bool thrown = false;
+    try
+    {
+        aligned_span<int, 64> misaligned(storage + 1, 4);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    assert_true(thrown);
+}
@@ -0,0 +1,75 @@
+#include "testing.hpp"
+
+#include "../useful/builder.hpp"
+
+using namespace uf;
+
+TEST(string_builder)
+{
+    string_builder b(64);
+    assert_true(b.empty());
+    assert_eq(b.str(), "");
+    assert_eq(b.pieces().size(), 0);
+
+    b.append("id=", 42, ',', -7, ' ', 2.5) << " end";
+    assert_eq(b.str(), "id=42,-7 2.5 end");
+    assert_eq(b.pieces().size(), 1);
+
+    // Long text fills chunks to the end, numbers start a new chunk rather than straddle one
+    const std::string long_text(170, 'x');
+    b.append(long_text, 1234567890123);
+    const std::string expected = "id=42,-7 2.5 end" + long_text + "1234567890123";
+    assert_eq(b.str(), expected);
+    assert_eq(b.size(), expected.size());
+    assert_eq(b.pieces().size(), 4);
+    for (const auto& piece : b.pieces())
+        assert_true(!piece.empty() && piece.size() <= 64);
+
+    // Views are referenced in place and split the written text
+    const std::string external = "<external>";
+    b.append_view(external).append("tail");
+    assert_eq(b.str(), expected + external + "tail");
+    assert_true(b.pieces()[b.pieces().size() - 2].data() == external.data());
+
+    std::string joined;
+    for (const auto& piece : b.pieces())
+        joined.append(piece.data(), piece.size());
+    assert_eq(joined, b.str());
+
+    std::vector<char> small(b.size() - 1), exact(b.size());
+    assert_eq(b.copy_to(span<char>(small)), 0);
+    assert_eq(b.copy_to(span<char>(exact)), b.size());
+    assert_eq(std::string(exact.begin(), exact.end()), b.str());
+
+    string_builder moved(std::move(b));
+    assert_eq(moved.str(), joined);
+    assert_true(b.empty());
+    b.append("fresh");
+    assert_eq(b.str(), "fresh");
+    assert_eq(moved.str(), joined);
+
+    chunk_pool pool(128);
+    {
+        string_builder first(pool);
+        first.append(std::string(300, 'a'));
+        assert_eq(first.pieces().size(), 3);
+    }
+    assert_eq(pool.free_count(), 3);
+    string_builder second(pool);
+    second.append(std::string(200, 'b'));
+    assert_eq(pool.free_count(), 1);
+    second.clear();
+    assert_eq(pool.free_count(), 3);
+    assert_true(second.empty());
+
+    bool thrown = false;
+    try
+    {
+        string_builder tiny(8);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    assert_true(thrown);
+}
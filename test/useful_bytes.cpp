@@ -0,0 +1,132 @@
+#include "testing.hpp"
+
+#include "../useful/bytes.hpp"
+
+using namespace uf;
+
+namespace
+{
+    template<typename Exception, typename F>
+    bool throws(F&& f)
+    {
+        try
+        {
+            f();
+        }
+        catch (const Exception&)
+        {
+            return true;
+        }
+        return false;
+    }
+}
+
+TEST(as_bytes)
+{
+    u32 words[2] = {0x01020304, 0x05060708};
+    span<u32> dynamic(words);
+    auto b = as_bytes(dynamic);
+    static_assert (std::is_same_v<decltype(b), span<const std::byte>>);
+    assert_eq(b.size(), 8);
+    auto fixed = as_writable_bytes(span<u32, 2>(words));
+    static_assert (std::is_same_v<decltype(fixed), span<std::byte, 8>>);
+    fixed[0] = std::byte{0xff};
+    assert_eq(words[0] & 0xff, 0xff);
+    assert_eq(load<u32>(b.first<4>()), words[0]);
+}
+
+TEST(byte_reader_writer)
+{
+    enum class kind : u16 { a = 1, b = 0x0203 };
+
+    std::vector<std::byte> buffer(128);
+    byte_writer w{span<std::byte>(buffer)};
+    w.write<u8>(0xab);
+    w.write_le<u16>(0x1234);
+    w.write_be<u32>(0x01020304);
+    w.write_fields(i64(-5), 1.5, 2.25f);
+    w.write_fields<byte_order::big>(kind::b, u8(7));
+    w.write_varint(0);
+    w.write_varint(300);
+    w.write_varint(std::numeric_limits<u64>::max());
+    w.write_varint_signed(-3);
+    w.write_string("hello");
+    w.write_string<u8, byte_order::big>("");
+    w.write_varint_string("wire");
+    const u64 end = w.position();
+    assert_eq(w.written().size(), end);
+
+    // Byte level layout of the fixed-width fields
+    assert_true(buffer[1] == std::byte{0x34} && buffer[2] == std::byte{0x12});
+    assert_true(buffer[3] == std::byte{0x01} && buffer[6] == std::byte{0x04});
+    assert_eq((load<u16, byte_order::big>(span<const std::byte>(buffer).subspan<27, 2>())), 0x0203);
+    assert_true(buffer[30] == std::byte{0} && buffer[31] == std::byte{0xac} && buffer[32] == std::byte{0x02});
+
+    byte_reader r(buffer);
+    assert_eq(r.read<u8>(), 0xab);
+    assert_eq(r.read_le<u16>(), 0x1234);
+    assert_eq(r.read_be<u32>(), 0x01020304);
+    i64 i = 0;
+    double d = 0;
+    float f = 0;
+    r.read_fields(i, d, f);
+    assert_true(i == -5 && d == 1.5 && f == 2.25f);
+    kind k = kind::a;
+    u8 small = 0;
+    r.read_fields<byte_order::big>(k, small);
+    assert_true(k == kind::b && small == 7);
+    assert_eq(r.read_varint(), 0);
+    assert_eq(r.read_varint(), 300);
+    assert_eq(r.read_varint(), std::numeric_limits<u64>::max());
+    assert_eq(r.read_varint_signed(), -3);
+    assert_eq(r.read_string(), "hello");
+    assert_eq((r.read_string<u8, byte_order::big>()), "");
+    assert_eq(r.read_varint_string(), "wire");
+    assert_eq(r.position(), end);
+
+    // Unchecked reads after one check
+    r.seek(3);
+    r.require(4);
+    assert_eq((r.read_unchecked<u32, byte_order::big>()), 0x01020304);
+
+    for (i64 v : {i64(0), i64(1), i64(-1), i64(63), i64(-64), std::numeric_limits<i64>::min(), std::numeric_limits<i64>::max()})
+    {
+        std::byte tmp[10];
+        byte_writer vw{span<std::byte>(tmp)};
+        vw.write_varint_signed(v);
+        byte_reader vr(vw.written());
+        assert_eq(vr.read_varint_signed(), v);
+        assert_true(vr.empty());
+    }
+}
+
+TEST(byte_reader_errors)
+{
+    const std::byte data[] = {std::byte{5}, std::byte{0}, std::byte{0}, std::byte{0}, std::byte{'a'}, std::byte{0x80}};
+    byte_reader r{span<const std::byte>(data)};
+    // A failed read leaves the cursor in place
+    assert_true(throws<std::out_of_range>([&]() { r.read_string(); }));
+    assert_eq(r.position(), 0);
+    assert_true(throws<std::out_of_range>([&]() { r.skip(7); }));
+    assert_true(throws<std::out_of_range>([&]() { r.seek(7); }));
+    r.seek(5);
+    assert_true(throws<std::out_of_range>([&]() { r.read_varint(); }));
+    assert_true(throws<std::out_of_range>([&]() { r.read<u16>(); }));
+    assert_true(throws<std::out_of_range>([&]() { r.read_bytes(2); }));
+    assert_eq(r.read_bytes(1).size(), 1);
+    assert_true(r.empty());
+
+    std::vector<std::byte> overlong(11, std::byte{0xff});
+    byte_reader o(overlong);
+    assert_true(throws<std::invalid_argument>([&]() { o.read_varint(); }));
+
+    std::byte out[4];
+    byte_writer w{span<std::byte>(out)};
+    assert_true(throws<std::out_of_range>([&]() { w.write<u64>(1); }));
+    assert_true(throws<std::out_of_range>([&]() { w.write_string("abc"); }));
+    assert_eq(w.position(), 0);
+    assert_true(throws<std::length_error>([&]() { w.write_string<u8>(std::string(300, 'x')); }));
+    w.write_fields(u16(1), u16(2));
+    assert_false(w.can_write(1));
+    assert_true(throws<std::out_of_range>([&]() { w.write_varint(0); }));
+}
@@ -0,0 +1,94 @@
+#include "testing.hpp"
+
+#include "../useful/chunks.hpp"
+
+using namespace uf;
+
+namespace
+{
+    template<class View>
+    std::vector<std::vector<int>> collect(const View& view)
+    {
+        std::vector<std::vector<int>> result;
+        for (const auto& part : view)
+            result.emplace_back(part.begin(), part.end());
+        return result;
+    }
+
+    using parts = std::vector<std::vector<int>>;
+}
+
+TEST(chunks)
+{
+    std::vector<int> v{1, 2, 3, 4, 5, 6, 7};
+    assert_true(collect(chunks(v, 3)) == (parts{{1, 2, 3}, {4, 5, 6}, {7}}));
+    assert_true(collect(chunks(v, 7)) == (parts{{1, 2, 3, 4, 5, 6, 7}}));
+    assert_true(collect(chunks(v, 100)) == (parts{{1, 2, 3, 4, 5, 6, 7}}));
+    assert_eq(chunks(v, 2).size(), 4);
+    assert_true(collect(chunks(v, ~u64(0))) == (parts{{1, 2, 3, 4, 5, 6, 7}}));
+
+    std::vector<int> none;
+    assert_true(chunks(none, 3).empty());
+    assert_true(windows(none, 3).empty());
+    assert_true(chunks_exact(none, 3).empty());
+
+    assert_true(collect(windows(v, 5)) == (parts{{1, 2, 3, 4, 5}, {2, 3, 4, 5, 6}, {3, 4, 5, 6, 7}}));
+    assert_eq(windows(v, 7).size(), 1);
+    assert_true(windows(v, 8).empty());
+
+    assert_true(collect(partition(v, 3)) == (parts{{1, 2, 3}, {4, 5}, {6, 7}}));
+    assert_true(collect(partition(v, 1)) == (parts{{1, 2, 3, 4, 5, 6, 7}}));
+    const auto sparse = partition(v, 9);
+    assert_eq(sparse.size(), 9);
+    assert_eq(sparse[6].size(), 1);
+    assert_true(sparse[7].empty() && sparse[8].empty());
+    assert_eq(sparse[8].data(), v.data() + v.size());
+
+    const auto exact = chunks_exact(v, 3);
+    assert_true(collect(exact) == (parts{{1, 2, 3}, {4, 5, 6}}));
+    assert_true(std::vector<int>(exact.remainder().begin(), exact.remainder().end()) == std::vector<int>{7});
+
+    // Static chunks carry their size in the type
+    const auto fixed = chunks_exact<2>(v);
+    static_assert (std::is_same_v<decltype(*fixed.begin()), span<int, 2>>);
+    assert_eq(fixed.size(), 3);
+    int sum = 0;
+    for (span<int, 2> pair : fixed)
+        sum += pair[0] * pair[1];
+    assert_eq(sum, 1 * 2 + 3 * 4 + 5 * 6);
+    assert_eq(fixed.remainder().size(), 1);
+
+    // Views write through to the storage and work from spans and random access algorithms
+    for (auto chunk : chunks(span<int>(v).subspan(1), 2))
+        chunk[0] = -chunk[0];
+    assert_true(v == (std::vector<int>{1, -2, 3, -4, 5, -6, 7}));
+    const auto c = chunks(v, 2);
+    assert_eq(c.end() - c.begin(), 4);
+    assert_eq((*(c.begin() + 3))[0], 7);
+    assert_eq(c.begin()[1][1], -4);
+
+    // Iterators outlive the view they came from and support the whole random access interface
+    auto it = chunks(v, 3).begin();
+    const auto last = windows(v, 6).end();
+    assert_eq((*it)[2], 3);
+    assert_eq((*(2 + it)).size(), 1);
+    assert_true(it < it + 1 && it + 1 > it && it <= it && it >= it && !(it + 2 <= it + 1));
+    assert_eq((*(last - 1))[5], 7);
+    assert_eq(std::distance(windows(v, 6).begin(), last), 2);
+    assert_true(std::is_sorted(it, it + 3, [](auto a, auto b){ return a.data() < b.data(); }));
+    assert_true(decltype(it)() == decltype(it)());
+
+    const std::vector<int> cv{1, 2};
+    static_assert (std::is_same_v<decltype(*chunks(cv, 1).begin()), span<const int>>);
+
+    bool thrown = false;
+    try
+    {
+        chunks(v, 0);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    assert_true(thrown);
+}
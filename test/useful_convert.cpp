@@ -0,0 +1,108 @@
+#include "testing.hpp"
+
+#include "../useful/convert.hpp"
+#include "../useful/strings.hpp"
+
+#include <random>
+
+using namespace uf;
+
+TEST(parse)
+{
+    assert_eq(parse<int>("-42"), std::optional<int>(-42));
+    assert_eq(parse<u8>("255"), std::optional<u8>(255));
+    assert_false(parse<u8>("256"));
+    assert_false(parse<int>("12a"));
+    assert_false(parse<int>(" 12"));
+    assert_false(parse<int>(""));
+    assert_eq(parse<double>("2.5e3"), std::optional<double>(2500));
+
+    int value = 7;
+    assert_true(parse("99999999999", value) == std::errc::result_out_of_range);
+    assert_true(parse("x", value) == std::errc::invalid_argument);
+    assert_eq(value, 7);
+    assert_true(parse("12a", value) == std::errc::invalid_argument);
+    assert_eq(value, 7);
+    double real = 0.5;
+    assert_true(parse("1.5e3x", real) == std::errc::invalid_argument);
+    assert_eq(real, 0.5);
+
+    char buffer[32];
+    for (double d : {0.1, -1e300, 3.0})
+        assert_eq(parse<double>(std::string_view(buffer, format_to(buffer, d))), std::optional<double>(d));
+    assert_eq(std::string_view(buffer, format_to(buffer, i64(-9000000000))), "-9000000000");
+    assert_eq(format_to(span<char>(buffer, 3), 1234), 0u);
+
+    const auto tokens = split(std::string("1,2,,30,x,4"), ',');
+    std::vector<int> column;
+    assert_eq(parse_into(tokens, column), 3u);
+    assert_true((column == std::vector<int>{1, 2, 30}));
+    column.clear();
+    assert_eq(parse_into(split(std::string("8 9z 10"), ' '), column), 1u);
+    assert_true((column == std::vector<int>{8}));
+    assert_false(parse_all<int>(tokens));
+    assert_true((parse_all<int>(split(std::string("5 6 7"), ' ')) == std::vector<int>{5, 6, 7}));
+}
+
+TEST(parse_fixed)
+{
+    std::mt19937_64 rng(3);
+    for (auto l : {simd::level::scalar, simd::level::avx2})
+    {
+        simd::limit(l);
+        for (int attempt = 0; attempt < 2000; ++attempt)
+        {
+            const u64 width = 1 + rng() % 20;
+            std::string field(width, '0');
+            for (auto& c : field)
+                c = '0' + rng() % 10;
+            const auto expected = parse<u64>(field.substr(std::min(field.find_first_not_of('0'), width - 1)));
+            assert_eq(parse_fixed<u64>(field), expected);
+            if (expected && *expected <= u64(std::numeric_limits<i64>::max()))
+                assert_eq(parse_fixed<i64>("-" + field), std::optional<i64>(-i64(*expected)));
+            field[rng() % width] = "/:a "[rng() % 4];
+            assert_false(parse_fixed<u64>(field));
+        }
+
+        for (u64 width = 1; width <= 19; ++width)
+        {
+            std::string records;
+            std::vector<u64> expected;
+            for (int i = 0; i < 50; ++i)
+            {
+                std::string field(width, '0');
+                for (auto& c : field)
+                    c = '0' + rng() % 10;
+                records += field + ';';
+                expected.push_back(*parse_fixed<u64>(field));
+            }
+            std::vector<u64> column;
+            assert_eq(parse_fixed_into(records, width, width + 1, column), expected.size());
+            assert_true(column == expected);
+        }
+
+        const char record[] = "0042-017x";
+        u64 id = 0;
+        i32 delta = 0;
+        assert_true(parse_fixed(span<const char, 4>(record), id) == std::errc());
+        assert_true(parse_fixed(span<const char, 4>(record + 4), delta) == std::errc());
+        assert_eq(id, 42);
+        assert_eq(delta, -17);
+        assert_true(parse_fixed(span<const char, 5>(record + 4), delta) == std::errc::invalid_argument);
+
+        assert_eq(parse_fixed<i8>("-128"), std::optional<i8>(-128));
+        assert_false(parse_fixed<i8>("128"));
+        assert_false(parse_fixed<u32>("-1"));
+        assert_false(parse_fixed<int>("-"));
+        assert_eq(parse_fixed<u64>("18446744073709551615"), std::optional<u64>(std::numeric_limits<u64>::max()));
+        assert_false(parse_fixed<u64>("18446744073709551616"));
+
+        const std::string records = "0012|0345|9999|12", bad = "001002x03";
+        std::vector<u32> column;
+        assert_eq(parse_fixed_into(records, 4, 5, column), 3u);
+        assert_true((column == std::vector<u32>{12, 345, 9999}));
+        column.clear();
+        assert_eq(parse_fixed_into(bad, 3, column), 2u);
+    }
+    simd::limit(simd::supported());
+}
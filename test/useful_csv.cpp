@@ -0,0 +1,109 @@
+#include "testing.hpp"
+
+#include "../useful/csv.hpp"
+
+#include <random>
+#include <thread>
+
+using namespace uf;
+
+namespace
+{
+    using table = std::vector<std::vector<std::string>>;
+
+    table random_table(std::mt19937& rng, char delimiter)
+    {
+        const char alphabet[] = {'a', 'b', delimiter, '"', '\n', '\r', ' '};
+        table result(rng() % 60);
+        for (auto& row : result)
+        {
+            row.resize(1 + rng() % 5);
+            for (auto& field : row)
+            {
+                field.resize(rng() % 4 ? rng() % 6 : rng() % 200);
+                for (auto& c : field)
+                    c = alphabet[rng() % (rng() % 3 ? 2 : sizeof(alphabet))];
+            }
+        }
+        return result;
+    }
+
+    std::string encode(const table& t, char delimiter)
+    {
+        std::string result;
+        for (const auto& row : t)
+        {
+            for (u64 i = 0; i < row.size(); ++i)
+            {
+                if (i)
+                    result += delimiter;
+                const std::string& field = row[i];
+                if (field.find_first_of(std::string{delimiter, '"', '\n', '\r'}) == std::string::npos)
+                    result += field;
+                else
+                {
+                    result += '"';
+                    for (char c : field)
+                        result += c == '"' ? std::string("\"\"") : std::string(1, c);
+                    result += '"';
+                }
+            }
+            result += '\n';
+        }
+        return result;
+    }
+
+    table read_all(csv_reader& reader)
+    {
+        table result;
+        for (const auto& row : reader)
+            result.emplace_back(row.begin(), row.end());
+        return result;
+    }
+}
+
+TEST(csv_reader)
+{
+    std::mt19937 rng(5);
+    for (auto l : {simd::level::scalar, simd::level::sse2, simd::level::avx2, simd::level::avx512})
+    {
+        simd::limit(l);
+        for (int attempt = 0; attempt < 30; ++attempt)
+        {
+            const csv_dialect dialect = attempt % 2 ? tsv_dialect : csv_dialect();
+            const table expected = random_table(rng, dialect.delimiter);
+            const std::string text = encode(expected, dialect.delimiter);
+
+            csv_reader from_memory(input_source(std::string_view(text)), dialect);
+            assert_true(read_all(from_memory) == expected);
+
+            // Small blocks through a pipe force rows to straddle refills
+            int fds[2];
+            assert_eq(pipe(fds), 0);
+            std::thread writer([&]()
+            {
+                for (u64 i = 0; i < text.size();)
+                {
+                    const ssize_t w = write(fds[1], text.data() + i, std::min<u64>(text.size() - i, 1 + rng() % 100));
+                    assert_true(w > 0);
+                    i += w;
+                }
+                close(fds[1]);
+            });
+            csv_reader from_pipe(input_source(fds[0], 16), dialect);
+            assert_true(read_all(from_pipe) == expected);
+            writer.join();
+            close(fds[0]);
+        }
+    }
+    simd::limit(simd::supported());
+
+    const std::string path = "useful_csv_test.csv";
+    std::ofstream(path) << "id,name\r\n1,\"Smith, \"\"J\"\"\"\r\n2,";
+    csv_reader reader(path);
+    assert_true((read_all(reader) == table{{"id", "name"}, {"1", "Smith, \"J\""}, {"2", ""}}));
+    std::remove(path.c_str());
+
+    csv_reader empty{input_source(std::string_view())};
+    assert_true(read_all(empty).empty());
+}
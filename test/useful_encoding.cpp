@@ -0,0 +1,155 @@
+#include "testing.hpp"
+
+#include "../useful/encoding.hpp"
+
+#include <random>
+
+using namespace uf;
+
+namespace
+{
+    std::vector<std::byte> bytes_of(std::string_view s)
+    {
+        std::vector<std::byte> result(s.size());
+        std::transform(s.begin(), s.end(), result.begin(), [](char c){ return static_cast<std::byte>(c); });
+        return result;
+    }
+
+    std::string hex_of(std::string_view s)
+    {
+        const auto data = bytes_of(s);
+        return hex_encode(data);
+    }
+
+    std::string base64_of(std::string_view s)
+    {
+        const auto data = bytes_of(s);
+        return base64_encode(data);
+    }
+
+    std::optional<std::string> hex_text(std::string_view text)
+    {
+        std::vector<std::byte> out(hex_decoded_size(text.size()));
+        const auto n = hex_decode(span<const char>(text.data(), text.size()), span<std::byte>(out));
+        if (!n)
+            return std::nullopt;
+        return std::string(reinterpret_cast<const char*>(out.data()), *n);
+    }
+
+    std::optional<std::string> base64_text(std::string_view text)
+    {
+        const span<const char> in(text.data(), text.size());
+        std::vector<std::byte> out(base64_decoded_size(in));
+        const auto n = base64_decode(in, span<std::byte>(out));
+        if (!n)
+            return std::nullopt;
+        return std::string(reinterpret_cast<const char*>(out.data()), *n);
+    }
+}
+
+TEST(hex)
+{
+    assert_eq(hex_of(""), "");
+    assert_eq(hex_of("\x01\xab\xff M"), "01abff204d");
+    assert_eq(*hex_text("01ABff204d"), std::string("\x01\xab\xff M"));
+    assert_false(hex_text("0"));
+    assert_false(hex_text("0g"));
+    assert_false(hex_text(" 1"));
+
+    const auto in = bytes_of("abc");
+    char small[5];
+    assert_eq(hex_encode(span<const std::byte>(in), span<char>(small, 5)), 0);
+    std::byte out[1];
+    assert_false(hex_decode(span<const char>("6162", 4), span<std::byte>(out, 1)));
+
+    std::mt19937 rng(5);
+    for (auto l : {simd::level::scalar, simd::level::sse2, simd::level::avx2})
+    {
+        simd::limit(l);
+        for (u64 size : {0, 1, 15, 16, 17, 31, 32, 33, 64, 100, 1000})
+        {
+            std::vector<std::byte> data(size);
+            for (auto& b : data)
+                b = static_cast<std::byte>(rng());
+            const std::string text = hex_encode(data);
+            assert_eq(text.size(), hex_encoded_size(size));
+            for (u64 i = 0; i < size; ++i)
+            {
+                const char expected[] = {detail::hex_digits[u8(data[i]) >> 4], detail::hex_digits[u8(data[i]) & 15]};
+                assert_eq(text.substr(2 * i, 2), std::string_view(expected, 2));
+            }
+            std::vector<std::byte> back(size);
+            assert_eq(*hex_decode(span<const char>(text), span<std::byte>(back)), size);
+            assert_true(back == data);
+            // Every position and every invalid char is caught, whichever kernel sees it
+            for (u64 i = 0; i < text.size(); i += 7)
+                for (int c = 0; c < 256; c += 3)
+                {
+                    std::string bad = text;
+                    bad[i] = static_cast<char>(c);
+                    assert_eq(bool(hex_decode(span<const char>(bad), span<std::byte>(back))), detail::hex_values[u8(c)] >= 0);
+                }
+        }
+    }
+    simd::limit(simd::supported());
+}
+
+TEST(base64)
+{
+    // RFC 4648 test vectors
+    const std::pair<std::string_view, std::string_view> vectors[] =
+        {{"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"}};
+    for (const auto& [plain, encoded] : vectors)
+    {
+        assert_eq(base64_of(plain), encoded);
+        assert_eq(base64_decoded_size(span<const char>(encoded.data(), encoded.size())), plain.size());
+        assert_eq(*base64_text(encoded), plain);
+    }
+    assert_eq(base64_of("\xfb\xff"), "+/8=");
+
+    assert_false(base64_text("Zg="));
+    assert_false(base64_text("Zg==Zg=="));
+    assert_false(base64_text("Z==="));
+    assert_false(base64_text("Zm=v"));
+    assert_false(base64_text("Zm9v\n"));
+    assert_false(base64_text("Zh=="));
+    assert_false(base64_text("Zm9="));
+    assert_false(base64_text("Zm-v"));
+
+    char small[7];
+    const auto in = bytes_of("foob");
+    assert_eq(base64_encode(span<const std::byte>(in), span<char>(small, 7)), 0);
+    std::byte out[3];
+    assert_false(base64_decode(span<const char>("Zm9vYg==", 8), span<std::byte>(out, 3)));
+
+    std::mt19937 rng(6);
+    for (auto l : {simd::level::scalar, simd::level::sse2, simd::level::avx2})
+    {
+        simd::limit(l);
+        for (u64 size : {0, 1, 2, 3, 11, 12, 13, 23, 24, 25, 28, 47, 48, 49, 100, 1000, 1001})
+        {
+            std::vector<std::byte> data(size);
+            for (auto& b : data)
+                b = static_cast<std::byte>(rng());
+            const std::string text = base64_encode(data);
+            assert_eq(text.size(), base64_encoded_size(size));
+            std::vector<std::byte> back(base64_decoded_size(span<const char>(text)));
+            assert_eq(back.size(), size);
+            assert_eq(*base64_decode(span<const char>(text), span<std::byte>(back)), size);
+            assert_true(back == data);
+            // Bytes of a larger buffer after the decoded ones are left intact
+            std::vector<std::byte> larger(size + 64, std::byte{0xa5});
+            assert_eq(*base64_decode(span<const char>(text), span<std::byte>(larger)), size);
+            assert_true(std::equal(data.begin(), data.end(), larger.begin()));
+            assert_true(std::all_of(larger.begin() + size, larger.end(), [](std::byte b){ return b == std::byte{0xa5}; }));
+            for (u64 i = 0; i + 4 < text.size(); i += 5)
+                for (int c = 0; c < 256; c += 3)
+                {
+                    std::string bad = text;
+                    bad[i] = static_cast<char>(c);
+                    assert_eq(bool(base64_decode(span<const char>(bad), span<std::byte>(back))), detail::base64_values[u8(c)] >= 0);
+                }
+        }
+    }
+    simd::limit(simd::supported());
+}
@@ -0,0 +1,77 @@
+#include "testing.hpp"
+
+#include "../useful/file.hpp"
+#include "../useful/strings.hpp"
+
+#include <random>
+#include <thread>
+
+using namespace uf;
+
+namespace
+{
+    std::vector<std::string> read_lines(mapped_lines& lines)
+    {
+        std::vector<std::string> result;
+        for (std::string_view line : lines)
+            result.emplace_back(line);
+        return result;
+    }
+}
+
+TEST(mapped_lines)
+{
+    std::mt19937 rng(3);
+    for (int attempt = 0; attempt < 30; ++attempt)
+    {
+        std::vector<std::string> expected(rng() % 50);
+        std::string text;
+        for (auto& line : expected)
+        {
+            line.assign(rng() % 4 ? rng() % 10 : rng() % 300, 'x');
+            for (auto& c : line)
+                c = "ab \r"[rng() % 4];
+            text += line + '\n';
+        }
+        // Without the final newline the last line is still there
+        if (attempt % 3 == 0 && !expected.empty() && !expected.back().empty())
+            text.pop_back();
+
+        mapped_lines from_memory{input_source(std::string_view(text))};
+        assert_true(read_lines(from_memory) == expected);
+
+        int fds[2];
+        assert_eq(pipe(fds), 0);
+        std::thread writer([&]()
+        {
+            for (u64 i = 0; i < text.size();)
+            {
+                const ssize_t w = write(fds[1], text.data() + i, std::min<u64>(text.size() - i, 1 + rng() % 50));
+                assert_true(w > 0);
+                i += w;
+            }
+            close(fds[1]);
+        });
+        mapped_lines from_pipe(input_source(fds[0], 16));
+        assert_true(read_lines(from_pipe) == expected);
+        writer.join();
+        close(fds[0]);
+    }
+
+    const std::string path = "useful_file_test.txt";
+    std::ofstream(path) << "  GET /a 200\r\n\nPOST /b 404  \n";
+    mapped_lines lines(path);
+    std::vector<std::vector<std::string>> tokens;
+    for (std::string_view line : lines)
+    {
+        const std::string_view trimmed = strip_view(line, ' ', '\r');
+        tokens.emplace_back();
+        for (auto [first, last] : split_itr(trimmed, ' '))
+            tokens.back().emplace_back(first, last);
+    }
+    assert_true((tokens == std::vector<std::vector<std::string>>{{"GET", "/a", "200"}, {}, {"POST", "/b", "404"}}));
+    std::remove(path.c_str());
+
+    mapped_lines empty{input_source(std::string_view())};
+    assert_true(read_lines(empty).empty());
+}
@@ -0,0 +1,83 @@
+#include "testing.hpp"
+
+#include "../useful/fuzzy.hpp"
+
+#include <random>
+
+using namespace uf;
+
+namespace
+{
+    u64 naive_levenshtein(std::string_view a, std::string_view b)
+    {
+        std::vector<u64> row(b.size() + 1);
+        std::iota(row.begin(), row.end(), 0);
+        for (u64 i = 1; i <= a.size(); ++i)
+        {
+            u64 diagonal = row[0];
+            row[0] = i;
+            for (u64 j = 1; j <= b.size(); ++j)
+            {
+                const u64 up = row[j];
+                row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] != b[j - 1])});
+                diagonal = up;
+            }
+        }
+        return row.back();
+    }
+
+    std::string mutate(std::string s, std::mt19937& rng, u64 edits)
+    {
+        for (u64 e = 0; e < edits; ++e)
+        {
+            const u64 at = s.empty() ? 0 : rng() % s.size();
+            switch (rng() % 3)
+            {
+            case 0:
+                s.insert(s.begin() + at, 'a' + rng() % 4);
+                break;
+            case 1:
+                if (!s.empty())
+                    s.erase(s.begin() + at);
+                break;
+            default:
+                if (!s.empty())
+                    s[at] = 'a' + rng() % 4;
+            }
+        }
+        return s;
+    }
+}
+
+TEST(levenshtein)
+{
+    assert_eq(levenshtein("kitten", "sitting"), 3u);
+    assert_eq(levenshtein("", "abc"), 3u);
+    assert_eq(levenshtein("flaw", "lawn"), 2u);
+    assert_eq(bounded_levenshtein("kitten", "sitting", 2), 3u);
+    assert_eq(bounded_levenshtein("kitten", "sitting", 3), 3u);
+    assert_eq(bounded_levenshtein("a", "abcdef", 1), 2u);
+
+    std::mt19937 rng(21);
+    // Lengths around one and two words exercise the single-word and blocked kernels
+    for (int attempt = 0; attempt < 400; ++attempt)
+    {
+        std::string a(rng() % 4 ? rng() % 70 : rng() % 200, 'a');
+        for (auto& c : a)
+            c = 'a' + rng() % 4;
+        const std::string b = rng() % 3 ? mutate(a, rng, rng() % 12) : mutate(std::string(), rng, rng() % 150);
+        const u64 expected = naive_levenshtein(a, b);
+        assert_eq(levenshtein(a, b), expected);
+        const levenshtein_pattern pattern(a);
+        assert_eq(pattern.distance(b), expected);
+        for (u64 k : {u64(0), u64(1), u64(3), u64(8), expected, expected + 1})
+        {
+            assert_eq(bounded_levenshtein(a, b, k), std::min(expected, k + 1));
+            assert_eq(pattern.bounded_distance(b, k), std::min(expected, k + 1));
+        }
+    }
+
+    const std::vector<std::string> names = {"Jonathan Smith", "Jon Smith", "Johnathan Smyth", "Jane Doe"};
+    assert_true((levenshtein_batch("Jonathan Smith", names) == std::vector<u64>{0, 5, 2, 11}));
+    assert_true((bounded_levenshtein_batch("Jonathan Smith", names, 2) == std::vector<u64>{0, 3, 2, 3}));
+}
@@ -0,0 +1,85 @@
+#include "testing.hpp"
+
+#include "../useful/hash.hpp"
+
+#include <set>
+#include <unordered_map>
+
+using namespace uf;
+
+namespace
+{
+    struct endpoint
+    {
+        std::string host;
+        u16 port;
+        double weight;
+    };
+
+    bool operator==(const endpoint& a, const endpoint& b)
+    {
+        return a.host == b.host && a.port == b.port && a.weight == b.weight;
+    }
+}
+
+TEST(hash_bytes)
+{
+    // Every length class of the kernel: empty, 1-3, 4-16, 17-48 and the 48 byte loop
+    std::string text;
+    std::set<u64> seen;
+    for (u64 n = 0; n <= 200; ++n)
+    {
+        const std::vector<std::byte> bytes(reinterpret_cast<const std::byte*>(text.data()), reinterpret_cast<const std::byte*>(text.data()) + n);
+        assert_eq(hash_bytes(bytes), hash_string(text));
+        assert_eq(hash_string(text), hash_string(std::string(text)));
+        assert_true(hash_string(text, 1) != hash_string(text));
+        seen.insert(hash_string(text));
+        text += static_cast<char>('a' + n % 26);
+    }
+    assert_eq(seen.size(), 201u);
+
+    // One flipped bit anywhere changes the hash
+    std::string flipped = text;
+    for (u64 i = 0; i < text.size(); ++i)
+    {
+        flipped[i] ^= 1;
+        assert_true(hash_string(flipped) != hash_string(text));
+        flipped[i] ^= 1;
+    }
+}
+
+TEST(hash_value)
+{
+    const std::string s = "key";
+    const std::string_view v = s;
+    assert_eq(hash_value(s), hash_value(v));
+    assert_eq(hash_value(s), hash_value("key"));
+    assert_eq(hash{}(s), hash{}("key"));
+    assert_true(equal_to{}(s, "key"));
+    assert_false(equal_to{}(v, "keys"));
+
+    assert_eq(hash_value(0.0), hash_value(-0.0));
+    assert_true(hash_value(1) != hash_value(2));
+    assert_eq(hash_value(std::vector<int>{1, 2, 3}), hash_value(std::array<int, 3>{1, 2, 3}));
+    assert_true(hash_value(std::vector<int>{1, 2}) != hash_value(std::vector<int>{2, 1}));
+    assert_eq(hash_value(std::pair(1, s)), hash_value(s, hash_value(1)));
+    assert_true(hash_value(std::optional<int>()) != hash_value(std::optional<int>(0)));
+
+    const endpoint a{"example.org", 443, 0.5}, b{"example.org", 443, 0.5}, c{"example.org", 80, 0.5};
+    assert_eq(hash_value(a), hash_value(b));
+    assert_eq(hash_value(a), hash_value(std::tuple(a.host, a.port, a.weight)));
+    assert_true(hash_value(a) != hash_value(c));
+
+    std::unordered_map<endpoint, int, hash, equal_to> weights;
+    weights[a] = 1;
+    weights[c] = 2;
+    assert_eq(weights.at(b), 1);
+
+    // Views into stable storage work as keys today, lookups by view never allocate
+    std::unordered_map<std::string_view, int, hash, equal_to> counts;
+    const std::vector<std::string> words = {"alpha", "beta", "alpha"};
+    for (const auto& w : words)
+        ++counts[w];
+    assert_eq(counts.at("alpha"), 2);
+    assert_eq(counts.count(std::string("beta")), 1u);
+}
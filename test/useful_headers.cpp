@@ -0,0 +1,39 @@
+#include "testing.hpp"
+
+// Every header together with mdspan.hpp first: headers that open uf::detail must still see one namespace
+#include "../useful/mdspan.hpp"
+#include "../useful/aligned.hpp"
+#include "../useful/arena.hpp"
+#include "../useful/base.hpp"
+#include "../useful/benchmark.hpp"
+#include "../useful/builder.hpp"
+#include "../useful/bytes.hpp"
+#include "../useful/chunks.hpp"
+#include "../useful/convert.hpp"
+#include "../useful/csv.hpp"
+#include "../useful/encoding.hpp"
+#include "../useful/file.hpp"
+#include "../useful/fuzzy.hpp"
+#include "../useful/hash.hpp"
+#include "../useful/import.hpp"
+#include "../useful/matcher.hpp"
+#include "../useful/meta.hpp"
+#include "../useful/pool.hpp"
+#include "../useful/search.hpp"
+#include "../useful/simd.hpp"
+#include "../useful/span.hpp"
+#include "../useful/strings.hpp"
+#include "../useful/typeid.hpp"
+#include "../useful/unicode.hpp"
+#include "../useful/utils.hpp"
+
+using namespace uf;
+
+TEST(all_headers)
+{
+    std::vector<int> v{1, 2, 3, 4, 5, 6};
+    const mdspan<int, dextents<2>> m(v.data(), 2, 3);
+    assert_eq(m(1, 2), 6);
+    assert_eq(uf::detail::varint_size(300), 2u);
+    assert_eq(chunks(v, 4).size(), 2u);
+}
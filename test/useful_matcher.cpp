@@ -0,0 +1,92 @@
+#include "testing.hpp"
+
+#include "../useful/matcher.hpp"
+#include "../useful/strings.hpp"
+
+#include <random>
+
+using namespace uf;
+
+namespace
+{
+    std::vector<multi_matcher::match> naive_find_all(const std::string& text, const std::vector<std::string>& patterns)
+    {
+        std::vector<multi_matcher::match> result;
+        for (u64 end = 0; end <= text.size(); ++end)
+            for (u64 p = 0; p < patterns.size(); ++p)
+                if (patterns[p].size() <= end && !text.compare(end - patterns[p].size(), patterns[p].size(), patterns[p]))
+                    result.push_back({p, end - patterns[p].size(), end});
+        return result;
+    }
+
+    void sort_matches(std::vector<multi_matcher::match>& v)
+    {
+        std::sort(v.begin(), v.end(), [](const auto& a, const auto& b)
+        {
+            return std::tie(a.end, a.pattern) < std::tie(b.end, b.pattern);
+        });
+    }
+}
+
+TEST(multi_matcher_find_all)
+{
+    std::mt19937 rng(7);
+    for (int attempt = 0; attempt < 200; ++attempt)
+    {
+        std::string text(rng() % 300, ' ');
+        for (auto& c : text)
+            c = "abc\xff"[rng() % 4];
+        std::vector<std::string> patterns(1 + rng() % 12);
+        for (auto& p : patterns)
+        {
+            p.resize(1 + rng() % 5);
+            for (auto& c : p)
+                c = "abc\xff"[rng() % 4];
+        }
+        // Duplicates and patterns that are prefixes or suffixes of each other
+        patterns.push_back(patterns.front());
+        patterns.push_back(patterns.front().substr(1));
+        patterns.push_back(patterns.back() + "a");
+
+        const multi_matcher m(patterns);
+        assert_eq(m.size(), patterns.size());
+        auto found = m.find_all(span<const char>(text.data(), text.size()));
+        auto expected = naive_find_all(text, patterns);
+        sort_matches(found);
+        sort_matches(expected);
+        assert_true(found == expected);
+        assert_eq(m.contains_any(span<const char>(text.data(), text.size())), !expected.empty());
+    }
+
+    const multi_matcher with_empty{"", "ab"};
+    assert_eq(with_empty.find_all(span<const char>("ab", 2)).size(), 4u);
+    assert_true(multi_matcher().find_all(span<const char>("ab", 2)).empty());
+}
+
+TEST(multi_matcher_predicate)
+{
+    const multi_matcher m{"he", "she", "hers"};
+    assert_true(m("ushers"));
+    assert_false(m("his"));
+    assert_true(stf_any(std::string("usher"), m));
+
+    std::set<std::string> words{"ushers", "his", "shell", "ale"};
+    remove_associative(words, m);
+    assert_true((words == std::set<std::string>{"his", "ale"}));
+
+    u64 seen = 0;
+    m.for_each_match(span<const char>("ushers", 6), [&seen](const auto&){ ++seen; return false; });
+    assert_eq(seen, 1u);
+
+    // Copies share the tables, so predicates built from a matcher do not copy the automaton
+    const u64 before = allocation_count();
+    const multi_matcher copy = m;
+    auto predicate = stf_any_obj(m);
+    assert_eq(allocation_count(), before);
+    assert_true(copy("hers"));
+    assert_true(predicate(std::string_view("she")));
+    assert_false(predicate(std::string_view("his")));
+
+    const multi_matcher delimiters{",", ";"};
+    assert_true((split(std::string("a,b;;c"), delimiters) == std::vector<std::string>{"a", "b", "c"}));
+}
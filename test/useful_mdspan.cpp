@@ -0,0 +1,109 @@
+#include "testing.hpp"
+
+#include "../useful/mdspan.hpp"
+
+using namespace uf;
+
+TEST(mdspan)
+{
+    static_assert (sizeof(extents<3, 4>) == 1 && extents<3, 4>().size() == 12);
+    static_assert (extents<3, dynamic_extent>::rank_dynamic() == 1);
+    static_assert (std::is_same_v<dextents<2>, extents<dynamic_extent, dynamic_extent>>);
+    assert_eq((extents<dynamic_extent, 4, dynamic_extent>(2, 5).extent(2)), 5);
+
+    std::vector<int> data(12);
+    std::iota(data.begin(), data.end(), 0);
+
+    // Row-major and column-major views of the same storage
+    mdspan<int, extents<3, 4>> rows(data.data());
+    mdspan<int, dextents<2>, layout_left> cols(data.data(), 4, 3);
+    assert_eq(rows(1, 2), 6);
+    assert_eq(cols(2, 1), 6);
+    assert_eq(rows.stride(0), 4);
+    assert_eq(cols.stride(1), 4);
+    assert_eq(rows.size(), 12);
+    assert_eq(rows.storage().size(), 12);
+    for (u64 i = 0; i < 3; ++i)
+        for (u64 j = 0; j < 4; ++j)
+            assert_eq(&rows(i, j), &cols(j, i));
+
+    mdspan<const int, extents<3, 4>> readonly = rows;
+    assert_eq(readonly(2, 3), 11);
+
+    bool thrown = false;
+    try
+    {
+        rows.at(3, 0);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    assert_true(thrown);
+
+    // Slices share the storage through strides
+    auto block = rows.submatrix(1, 1, 2, 2);
+    assert_eq(block.extent(0), 2);
+    assert_eq(block(0, 0), 5);
+    assert_eq(block(1, 1), 10);
+    block(1, 0) = -9;
+    assert_eq(data[9], -9);
+    assert_eq(rows.submatrix(2, 3, 5, 5).size(), 1);
+    assert_eq(rows.submatrix(3, 0, 1, 1).size(), 0);
+    auto column = rows.column(2);
+    assert_eq(column.extent(0), 3);
+    assert_eq(column(2), 10);
+    auto row = cols.row(1);
+    assert_eq(row.extent(0), 3);
+    assert_eq(row(2), -9);
+    assert_eq(block.column(0)(1), -9);
+
+    std::vector<int> cube(24);
+    std::iota(cube.begin(), cube.end(), 0);
+    mdspan<int, dextents<3>> c(span<int>(cube), 2, 3, 4);
+    assert_eq(c(1, 2, 3), 23);
+    auto inner = c.slice({1, 1, 1}, {1, 2, 2});
+    assert_eq(inner(0, 1, 1), c(1, 2, 2));
+    assert_eq(inner.mapping().required_span_size(), 4 + 1 + 1);
+
+    thrown = false;
+    try
+    {
+        mdspan<int, dextents<2>> small(span<int>(cube), 5, 5);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    assert_true(thrown);
+
+    // Tiles pad partial edges, copy converts between layouts
+    using tiled = mdspan<int, dextents<2>, layout_tiled<2, 4>>;
+    std::vector<int> tile_storage(tiled::mapping_type(dextents<2>(5, 6)).required_span_size(), 0);
+    assert_eq(tile_storage.size(), 3 * 2 * 8);
+    std::vector<int> matrix(30);
+    std::iota(matrix.begin(), matrix.end(), 0);
+    mdspan<int, dextents<2>> source(matrix.data(), 5, 6);
+    tiled t(tile_storage.data(), 5, 6);
+    copy(source, t);
+    assert_eq(t(0, 3), 3);
+    assert_eq(tile_storage[3], 3);
+    assert_eq(tile_storage[4], 6);
+    assert_eq(tile_storage[8], 4);
+    assert_eq(tile_storage[16], 12);
+    static_assert (layout_tiled<2, 4>::mapping<extents<5, 6>>().required_span_size() == 48);
+    std::vector<int> seen;
+    for_each_index(t.extents(), [&](const auto& index) { seen.push_back(t[index]); });
+    assert_true(seen == matrix);
+
+    thrown = false;
+    try
+    {
+        copy(source, rows);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    assert_true(thrown);
+}
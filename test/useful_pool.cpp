@@ -0,0 +1,92 @@
+#include "testing.hpp"
+
+#include "../useful/pool.hpp"
+
+#include <random>
+#include <thread>
+
+using namespace uf;
+
+TEST(string_pool)
+{
+    string_pool pool(256);
+    assert_eq(pool.find("GET"), string_pool::npos);
+    const auto get = pool.intern("GET");
+    const auto post = pool.intern(std::string("POST"));
+    assert_eq(get, 0u);
+    assert_eq(post, 1u);
+    assert_eq(pool.intern(std::string_view("GETX", 3)), get);
+    assert_eq(pool.find("POST"), post);
+    assert_eq(pool.intern(""), 2u);
+
+    const std::string_view stable = pool.intern_view("GET");
+    std::vector<std::string> words;
+    for (int i = 0; i < 5000; ++i)
+        words.push_back("host-" + std::to_string(i % 1000));
+    for (const auto& w : words)
+        pool.intern(w);
+    assert_eq(pool.size(), 1003u);
+    assert_true(stable.data() == pool.view(get).data());
+    for (int i = 0; i < 1000; ++i)
+        assert_eq(pool.view(pool.find("host-" + std::to_string(i))), "host-" + std::to_string(i));
+
+    const std::string line = "GET /a GET /b POST /a";
+    const auto symbols = split_symbols(pool, line, ' ');
+    assert_eq(symbols.size(), 6u);
+    assert_eq(symbols[0], get);
+    assert_eq(symbols[0], symbols[2]);
+    assert_eq(symbols[1], symbols[5]);
+    assert_eq(symbols[4], post);
+
+    // Running out of symbols leaves the pool unchanged
+    string_pool small;
+    assert_eq(small.intern("a", hash_string("a"), 1), 0u);
+    bool thrown = false;
+    try
+    {
+        small.intern("b", hash_string("b"), 1);
+    }
+    catch (const std::length_error&)
+    {
+        thrown = true;
+    }
+    assert_true(thrown);
+    assert_eq(small.size(), 1u);
+    assert_eq(small.find("b"), string_pool::npos);
+    assert_eq(small.intern("a", hash_string("a"), 1), 0u);
+    assert_eq(small.intern("b"), 1u);
+}
+
+TEST(concurrent_string_pool)
+{
+    concurrent_string_pool pool(8);
+    std::vector<std::vector<concurrent_string_pool::symbol>> seen(4);
+    std::vector<std::thread> threads;
+    for (u64 t = 0; t < seen.size(); ++t)
+    {
+        threads.emplace_back([&pool, &seen, t]()
+        {
+            std::mt19937 rng(t);
+            for (int i = 0; i < 20000; ++i)
+            {
+                const int k = rng() % 2000;
+                const auto id = pool.intern("key" + std::to_string(k));
+                if (seen[t].size() <= static_cast<u64>(k))
+                    seen[t].resize(k + 1, concurrent_string_pool::npos);
+                assert_true(seen[t][k] == concurrent_string_pool::npos || seen[t][k] == id);
+                seen[t][k] = id;
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    assert_eq(pool.size(), 2000u);
+    for (int k = 0; k < 2000; ++k)
+    {
+        const auto id = pool.find("key" + std::to_string(k));
+        assert_eq(pool.view(id), "key" + std::to_string(k));
+        for (const auto& s : seen)
+            assert_true(s.size() <= static_cast<u64>(k) || s[k] == concurrent_string_pool::npos || s[k] == id);
+    }
+}
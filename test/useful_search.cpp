@@ -0,0 +1,77 @@
+#include "testing.hpp"
+
+#include "../useful/search.hpp"
+
+#include <random>
+
+using namespace uf;
+
+TEST(find)
+{
+    std::mt19937 rng(1);
+    std::string haystack(3000, ' ');
+    for (auto& c : haystack)
+        c = "ab\xff"[rng() % 3];
+
+    for (auto l : {simd::level::scalar, simd::level::sse2, simd::level::avx2, simd::level::avx512})
+    {
+        simd::limit(l);
+        for (u64 k : {0, 1, 2, 3, 5, 8, 17, 31, 32, 33, 70})
+        {
+            for (int attempt = 0; attempt < 5; ++attempt)
+            {
+                const u64 at = rng() % (haystack.size() - k);
+                const std::string needle = attempt ? haystack.substr(at, k) : std::string(k, 'c');
+                const searcher compiled(needle);
+                for (u64 pos : {u64(0), u64(1), at, haystack.size() - k, haystack.size(), haystack.size() + 1})
+                {
+                    const u64 expected = std::string_view(haystack).find(needle, pos);
+                    assert_eq(uf::find(haystack, needle, pos), expected);
+                    assert_eq(compiled.find(haystack, pos), expected);
+                }
+                assert_eq(contains(haystack, needle), std::string_view(haystack).find(needle) != std::string_view::npos);
+            }
+        }
+    }
+    simd::limit(simd::supported());
+
+    assert_true(contains("hello world", "o w"));
+    assert_false(contains("hello world", "ow"));
+}
+
+TEST(count)
+{
+    assert_eq(count("aaaa", "aa"), 2);
+    assert_eq(count("abcabcab", "abc"), 2);
+    assert_eq(count("abc", "d"), 0);
+    assert_eq(count("abc", ""), 0);
+    assert_eq(count("", ""), 0);
+    assert_eq(count(std::string(100, 'x') + std::string(40, 'y') + std::string(100, 'x'), std::string(40, 'y')), 1);
+
+    // One-shot forms build no searcher, long needles included and at every level
+    const std::string text = std::string(50, 'x') + "needle-of-twenty-bytes" + std::string(50, 'x') + "needle-of-twenty-bytes";
+    const std::string_view needle = "needle-of-twenty-bytes";
+    for (auto l : {simd::level::scalar, simd::supported()})
+    {
+        simd::limit(l);
+        const u64 before = allocation_count();
+        assert_eq(count(text, needle), 2);
+        assert_eq(count(text, "xx"), 50);
+        assert_eq(allocation_count(), before);
+        const std::string replaced = replace_all(text, needle, "NEEDLE-OF-TWENTY-BYTES");
+        assert_eq(allocation_count(), before + 1);
+        assert_eq(count(replaced, "NEEDLE-OF-TWENTY-BYTES"), 2);
+    }
+    simd::limit(simd::supported());
+}
+
+TEST(replace_all)
+{
+    assert_eq(replace_all("a.b.c", ".", "::"), "a::b::c");
+    assert_eq(replace_all("aaaa", "aa", "b"), "bb");
+    assert_eq(replace_all("abc", "", "x"), "abc");
+    assert_eq(replace_all("", "", "x"), "");
+    assert_eq(replace_all("abc", "abc", ""), "");
+    const searcher dot(".");
+    assert_eq(replace_all("1.2.3", dot, ""), "123");
+}
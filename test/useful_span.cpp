@@ -0,0 +1,94 @@
+#include "testing.hpp"
+
+#include "../useful/span.hpp"
+
+using namespace uf;
+
+TEST(static_span)
+{
+    static_assert (sizeof(span<int, 16>) == sizeof(int*));
+    static_assert (span<int, 16>::size() == 16 && span<int, 16>::extent == 16);
+    static_assert (span<int>::extent == dynamic_extent);
+
+    int raw[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    span<int, 8> s(raw);
+    assert_eq(s.size(), 8);
+    assert_false(s.empty());
+    assert_eq(s.front(), 1);
+    assert_eq(s.back(), 8);
+    assert_eq(std::accumulate(s.begin(), s.end(), 0), 36);
+    assert_eq(*s.rbegin(), 8);
+
+    // Parts keep the extent in the type
+    auto head = s.first<3>();
+    auto tail = s.last<2>();
+    auto middle = s.subspan<2, 4>();
+    auto rest = s.subspan<5>();
+    static_assert (std::is_same_v<decltype(head), span<int, 3>>);
+    static_assert (std::is_same_v<decltype(tail), span<int, 2>>);
+    static_assert (std::is_same_v<decltype(middle), span<int, 4>>);
+    static_assert (std::is_same_v<decltype(rest), span<int, 3>>);
+    assert_eq(head[2], 3);
+    assert_eq(tail[0], 7);
+    assert_eq(middle.front(), 3);
+    assert_eq(middle.back(), 6);
+    assert_eq(rest.front(), 6);
+    middle[0] = 30;
+    assert_eq(raw[2], 30);
+
+    // Conversions: to const, to and from dynamic
+    span<const int, 8> cs = s;
+    span<const int> dynamic = cs;
+    assert_eq(dynamic.size(), 8);
+    assert_eq(dynamic.data(), raw);
+    span<const int, 8> back(dynamic);
+    assert_eq(back.data(), raw);
+    bool thrown = false;
+    try
+    {
+        span<const int, 4> wrong(dynamic);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    assert_true(thrown);
+
+    auto sub = s.subspan(6, 10);
+    static_assert (std::is_same_v<decltype(sub), span<int>>);
+    assert_eq(sub.size(), 2);
+
+    std::array<u8, 4> arr{{9, 8, 7, 6}};
+    span<const u8, 4> from_array(arr);
+    assert_eq(from_array[3], 6);
+    thrown = false;
+    try
+    {
+        from_array.at(4);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    assert_true(thrown);
+
+    // Dynamic spans hand out static parts after one size check
+    std::vector<int> v(raw, raw + 8);
+    span<int> dv(v);
+    span<int, 4> dfirst = dv.first<4>();
+    assert_eq(dfirst[3], 4);
+    assert_eq(dv.last<1>()[0], 8);
+    assert_eq((dv.subspan<6, 2>()[1]), 8);
+    assert_eq(dv.first(2).size(), 2);
+    assert_eq(dv.last(3)[0], 6);
+    thrown = false;
+    try
+    {
+        dv.subspan<7, 2>();
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    assert_true(thrown);
+}
@@ -0,0 +1,286 @@
+#include "testing.hpp"
+
+#include "../useful/strings.hpp"
+
+#include <random>
+
+using namespace uf;
+
+TEST(split_view)
+{
+    {
+        std::string s("  xx xx  x   ");
+        std::vector<std::string_view> tokens;
+        for (std::string_view token : split_view(s, ' '))
+            tokens.push_back(token);
+        assert_eq(tokens.size(), 3);
+        assert_eq(tokens[0], "xx");
+        assert_eq(tokens[1], "xx");
+        assert_eq(tokens[2], "x");
+        assert_eq(tokens[2].data(), s.data() + 9);
+    }
+
+    {
+        const std::vector<std::string> lines{"", " ", "a", " a", "a ", "a,b;;c", ";a;b,c,", "abc ,; d"};
+        for (const auto& line : lines)
+        {
+            for (u64 n : {u64(0), u64(1), u64(2), u64(10)})
+            {
+                auto expected = split_n(line, n, ' ', ',', [](char c){ return c == ';'; });
+                std::vector<std::string> actual;
+                for (auto token : split_view_n(line, n, ' ', ',', [](char c){ return c == ';'; }))
+                    actual.emplace_back(token);
+                assert_eq(actual, expected);
+            }
+        }
+    }
+
+    {
+        std::vector<int> v{0, 1, 2, 0, 0, 3};
+        std::vector<u64> sizes;
+        for (auto token : split_view(v, 0))
+            sizes.push_back(token.size());
+        assert_eq(sizes, std::vector<u64>({2, 1}));
+    }
+}
+
+TEST(split_chars)
+{
+    const auto check = [](const std::string& s, u64 n, auto... ds)
+    {
+        const auto expected = split_n(s, n, [=](char c){ return ((c == ds) || ...); });
+        assert_eq(split_n(s, n, ds...), expected);
+    };
+
+    std::string alphabet = "ab\t\n ,;:|.-_=+*/\x80\xff";
+    std::mt19937 rng(42);
+    for (auto l : {simd::level::scalar, simd::level::sse2, simd::level::avx2, simd::level::avx512})
+    {
+        simd::limit(l);
+        for (u64 size : {0, 1, 63, 64, 65, 200, 1023, 1024, 1025, 3000})
+        {
+            std::string s(size, ' ');
+            for (auto& c : s)
+                c = alphabet[rng() % alphabet.size()];
+            for (u64 n : {u64(0), u64(1), u64(7), std::numeric_limits<u64>::max()})
+            {
+                check(s, n, '\t');
+                check(s, n, '\t', '\n');
+                check(s, n, ' ', ',', ';', ':', '|', '.', '-', '_', '=', '+', '*');
+                check(s, n, 'a', '\x80', '\xff', '\t', '\n', ' ', ',', ';', ':', '|');
+            }
+        }
+    }
+    simd::limit(simd::supported());
+
+    const std::string_view tsv = "id\tname\t\tvalue\n";
+    const auto bounds = split_itr(tsv, '\t', '\n');
+    assert_eq(bounds.size(), 3);
+    assert_eq(bounds[1].first, tsv.begin() + 3);
+    assert_eq(bounds[1].second, tsv.begin() + 7);
+}
+
+TEST(split_into)
+{
+    const std::string line = " GET  /index.html HTTP/1.1 ";
+
+    {
+        std::string_view tokens[4];
+        auto last = split_into(line, tokens, ' ');
+        assert_eq(last - tokens, 3);
+        assert_eq(tokens[0], "GET");
+        assert_eq(tokens[2], "HTTP/1.1");
+        assert_eq(tokens[0].data(), line.data() + 1);
+    }
+
+    {
+        std::vector<std::string> tokens{"stale"};
+        split_into(line, tokens, [](char c){ return c == ' '; });
+        assert_eq(tokens, split(line, ' '));
+
+        std::vector<std::string_view> views;
+        split_into_n(line, 2, std::back_inserter(views), ' ', '/');
+        assert_eq(views.size(), 2);
+        assert_eq(views[1], "index.html");
+    }
+
+    {
+        monotonic_arena arena(64);
+        std::vector<std::string_view> tokens;
+        for (int i = 0; i < 3; ++i)
+        {
+            arena.reset();
+            std::string source = line;
+            split_into(source, tokens, arena, ' ');
+            source.assign(source.size(), 'x');
+            assert_eq(tokens.size(), 3);
+            assert_eq(tokens[1], "/index.html");
+        }
+        const u64 capacity = arena.capacity();
+        arena.reset();
+        split_into(line, tokens, arena, ' ');
+        assert_eq(arena.capacity(), capacity);
+    }
+
+    {
+        const std::vector<int> v{0, 1, 2, 0, 3};
+        std::vector<span<const int>> tokens;
+        monotonic_arena arena;
+        split_into(v, tokens, arena, 0);
+        assert_eq(tokens.size(), 2);
+        assert_eq(tokens[0].size(), 2);
+        assert_eq(tokens[1][0], 3);
+        assert_true(tokens[1].data() != v.data() + 4);
+    }
+}
+
+TEST(concat_join)
+{
+    const std::string host = "example.org";
+    assert_eq(concat("GET ", std::string_view("/index"), ' ', host, ':', 8080, " took ", 1.5, "ms"), "GET /index example.org:8080 took 1.5ms");
+    assert_eq(concat(), "");
+    assert_eq(concat(std::string_view(), 'a', std::string_view()), "a");
+    assert_eq(concat(i64(-9223372036854775807 - 1), ' ', u64(18446744073709551615u), ' ', u8(0), ' ', -0.25), "-9223372036854775808 18446744073709551615 0 -0.25");
+
+    for (u64 v = 1, digits = 1; digits <= 20; v *= 10, ++digits)
+    {
+        assert_eq(concat(v), std::to_string(v));
+        assert_eq(concat(v - 1), std::to_string(v - 1));
+        if (digits == 20)
+            break;
+    }
+
+    std::string line = "id=";
+    line.reserve(64);
+    const char* before = line.data();
+    assert_eq(append_to(line, 42, ", name=", host), "id=42, name=example.org");
+    assert_true(line.data() == before);
+    assert_eq(append_to(line), "id=42, name=example.org");
+
+    assert_eq(join(std::vector<std::string>{"a", "bc", "", "d"}, ", "), "a, bc, , d");
+    assert_eq(join(std::vector<int>{1, -2, 30}, ','), "1,-2,30");
+    assert_eq(join(std::vector<std::string_view>{}, ","), "");
+    assert_eq(join(split(std::string("x y  z"), ' '), '-'), "x-y-z");
+}
+
+TEST(strip_view)
+{
+    std::mt19937 rng(9);
+    for (auto l : {simd::level::scalar, simd::level::sse2, simd::level::avx2, simd::level::avx512})
+    {
+        simd::limit(l);
+        for (int attempt = 0; attempt < 500; ++attempt)
+        {
+            std::string s(rng() % 300, ' ');
+            for (auto& c : s)
+                c = rng() % 4 ? " \t\n"[rng() % 3] : 'a' + rng() % 26;
+            const std::string_view sv = s;
+            assert_eq(lstrip_view(s, ' ', '\t', '\n'), lstrip(s, ' ', '\t', '\n'));
+            assert_eq(rstrip_view(s, ' ', '\t', '\n'), rstrip(s, ' ', '\t', '\n'));
+            assert_eq(strip_view(sv, ' ', '\t', '\n'), strip(s, ' ', '\t', '\n'));
+            assert_true(strip_view(s, ' ', '\t', '\n').data() >= s.data());
+
+            const std::string padded = std::string(rng() % 200, ' ') + "x y" + std::string(rng() % 200, '\t');
+            assert_eq(strip_view(padded, ' ', '\t'), "x y");
+        }
+    }
+    simd::limit(simd::supported());
+
+    const std::string s = "  payload \n";
+    assert_eq(strip_view(s, ' ', '\n'), "payload");
+    assert_true(strip_view(s, ' ', '\n').data() == s.data() + 2);
+    assert_eq(strip_view(s, [](char c){ return c == ' ' || c == '\n'; }), "payload");
+    assert_eq(strip_view(std::string_view("   "), ' '), "");
+
+    std::vector<int> v{0, 0, 1, 2, 0};
+    const auto stripped = strip_view(v, 0);
+    assert_eq(stripped.size(), 2u);
+    assert_true(stripped.data() == v.data() + 2);
+}
+
+TEST(parallel_split)
+{
+    std::mt19937 rng(13);
+    for (int attempt = 0; attempt < 6; ++attempt)
+    {
+        // Long delimiter runs and long tokens make cuts land inside both
+        std::string s(300000 + rng() % 100000, 'x');
+        for (u64 i = 0; i < s.size();)
+        {
+            const u64 run = rng() % 4 ? rng() % 8 : rng() % 70000;
+            const char c = rng() % 2 ? 'a' + rng() % 26 : " \n"[rng() % 2];
+            for (u64 k = 0; k < run && i < s.size(); ++k)
+                s[i++] = c;
+        }
+        const auto expected = split_itr(s, ' ', '\n');
+        for (u32 threads : {0u, 1u, 3u, 4u, 16u})
+        {
+            assert_true(parallel_split(s, threads, ' ', '\n') == expected);
+            std::vector<std::pair<std::string::const_iterator, std::string::const_iterator>> joined;
+            for (const auto& chunk : parallel_split_chunks(s, threads, ' ', '\n'))
+                joined.insert(joined.end(), chunk.begin(), chunk.end());
+            assert_true(joined == expected);
+        }
+        const auto is_space = [](char c) { return c == ' ' || c == '\n'; };
+        assert_true(parallel_split(s, 4, is_space) == split_itr(s, is_space));
+    }
+
+    // One token with no delimiter after the cuts
+    const std::string one(1 << 20, 'x');
+    assert_eq(parallel_split(one, 4, ' ').size(), 1u);
+    std::vector<int> v(1 << 19, 1);
+    for (u64 i = 0; i < v.size(); i += 1 + rng() % 100)
+        v[i] = 0;
+    assert_true(parallel_split(v, 4, 0) == split_itr(v, 0));
+    assert_true(parallel_split(std::string(), 4, ' ').empty());
+}
+
+TEST(iequals)
+{
+    const auto lower = [](std::string s)
+    {
+        for (auto& c : s)
+            c = std::tolower(static_cast<unsigned char>(c));
+        return s;
+    };
+    std::mt19937 rng(17);
+    // Neighbours of the letter ranges differ from each other by 0x20 too and must not compare equal
+    const char alphabet[] = "aAzZqQ@`[{_\x7f\xc1\xe1 0";
+    for (auto l : {simd::level::scalar, simd::level::sse2, simd::level::avx2})
+    {
+        simd::limit(l);
+        for (int attempt = 0; attempt < 3000; ++attempt)
+        {
+            std::string a(rng() % 80, ' ');
+            for (auto& c : a)
+                c = alphabet[rng() % (sizeof(alphabet) - 1)];
+            std::string b = a;
+            for (auto& c : b)
+                if (rng() % 3 == 0)
+                    c = rng() % 2 ? std::toupper(static_cast<unsigned char>(c)) : alphabet[rng() % (sizeof(alphabet) - 1)];
+            assert_eq(iequals(a, b), lower(a) == lower(b));
+            const std::string p = b.substr(0, rng() % (b.size() + 1));
+            const std::string q = b.substr(b.size() - rng() % (b.size() + 1));
+            assert_eq(istarts_with(a, p), starts_with(lower(a), lower(p)));
+            assert_eq(iends_with(a, q), ends_with(lower(a), lower(q)));
+            const std::string needle = a.substr(rng() % (a.size() + 1)).substr(0, rng() % 6);
+            std::string hay = b + b;
+            assert_eq(ifind(hay, needle), lower(hay).find(lower(needle)));
+            if (!hay.empty())
+                hay[rng() % hay.size()] ^= 0x20;
+            assert_eq(ifind(hay, needle, 3), lower(hay).find(lower(needle), 3));
+        }
+    }
+    simd::limit(simd::supported());
+
+    const std::string header = "Content-Type: text/HTML";
+    assert_true(istarts_with(header, "content-type"));
+    assert_true(iends_with(header, "html"));
+    assert_true(istarts_with(header, 'c'));
+    assert_true(iends_with(header, 'L'));
+    assert_true(iequals(std::string_view("GET"), "get"));
+    assert_false(iequals(std::string_view("GET"), "got"));
+    assert_false(istarts_with(std::string("@"), "`"));
+    assert_eq(ifind(header, "TEXT/html"), 14u);
+    assert_eq(ifind(header, "xml"), std::string_view::npos);
+}
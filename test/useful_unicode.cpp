@@ -0,0 +1,70 @@
+#include "testing.hpp"
+
+#include "../useful/unicode.hpp"
+
+#include <random>
+
+using namespace uf;
+
+TEST(utf8_validate)
+{
+    const std::vector<std::pair<std::string, bool>> cases = {
+        {"", true}, {"plain ascii", true}, {"\xd0\x9f\xd1\x80\xd0\xb8", true}, {"\xe2\x82\xac", true},
+        {"\xf0\x9f\x98\x80", true}, {"\xf4\x8f\xbf\xbf", true}, {"\xef\xbf\xbf", true},
+        {"\x80", false}, {"\xc0\xaf", false}, {"\xc1\xbf", false}, {"\xe0\x80\xaf", false}, {"\xf0\x80\x80\xaf", false},
+        {"\xed\xa0\x80", false}, {"\xf4\x90\x80\x80", false}, {"\xf5\x80\x80\x80", false}, {"\xff", false},
+        {"\xe2\x82", false}, {"\xf0\x9f\x98", false}, {"\xc3", false}, {"\xc3\xa9\xa9", false}};
+
+    std::mt19937 rng(11);
+    const std::vector<std::string> pieces = {"a", "z ", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\x80", "\xc3", "\xed\xa0\x80", "\xe0\x80"};
+    for (auto l : {simd::level::scalar, simd::level::avx2})
+    {
+        simd::limit(l);
+        assert_true(utf8_validate(span<const char>()));
+        for (const auto& [s, valid] : cases)
+        {
+            assert_eq(utf8_validate(s), valid);
+            // Same check at every offset across a block boundary
+            for (u64 pad : {u64(1), u64(29), u64(30), u64(31), u64(32), u64(62)})
+            {
+                const std::string padded = std::string(pad, 'x') + s + std::string(pad % 3, 'y');
+                assert_eq(utf8_validate(padded), valid);
+            }
+        }
+        for (int attempt = 0; attempt < 3000; ++attempt)
+        {
+            std::string s;
+            const bool clean = attempt % 2;
+            for (u64 k = rng() % 80; k--;)
+                s += pieces[rng() % (clean ? 5 : pieces.size())];
+            assert_eq(utf8_validate(s), detail::utf8_validate_scalar(s.data(), s.size()));
+            if (clean)
+                assert_true(utf8_validate(s));
+        }
+    }
+    simd::limit(simd::supported());
+}
+
+TEST(casefold)
+{
+    assert_eq(casefold(U'A'), U'a');
+    assert_eq(casefold(U'Σ'), U'σ');
+    assert_eq(casefold(U'ς'), U'σ');
+    assert_eq(casefold(U'K'), U'k');
+    assert_eq(casefold(U'ẞ'), U'ß');
+    assert_eq(casefold(U'ß'), U'ß');
+    assert_eq(casefold(U'ꭰ'), U'Ꭰ');
+    assert_eq(casefold(U'\U00010400'), U'\U00010428');
+    assert_eq(casefold(U'ā'), U'ā');
+    assert_eq(casefold(U'Ā'), U'ā');
+
+    for (auto l : {simd::level::scalar, simd::level::avx2})
+    {
+        simd::limit(l);
+        assert_eq(casefold(std::string_view("Hello, WORLD! The quick brown FOX jumps over")), "hello, world! the quick brown fox jumps over");
+        assert_eq(casefold(std::string_view("\xd0\x9f\xd0\xa0\xd0\x98\xd0\x92\xd0\x95\xd0\xa2 World")), "\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 world");
+        assert_eq(casefold(std::string_view("\xe2\x84\xaa" "ELVIN \xc8\xba")), "kelvin \xe2\xb1\xa5");
+        assert_eq(casefold(std::string_view("BAD\xff\xc3")), "bad\xff\xc3");
+    }
+    simd::limit(simd::supported());
+}
@@ -0,0 +1,72 @@
+#include "testing.hpp"
+
+#include "../useful/strings.hpp"
+
+#include <set>
+
+using namespace uf;
+
+TEST(stf_any_obj_literals)
+{
+    {
+        auto f = stf_any_obj('a', 'e', 'i', 'o', 'u', 'A', 'E', 'I', 'O', 'U', '\xff');
+        for (int i = -128; i < 128; ++i)
+        {
+            const char c = static_cast<char>(i);
+            assert_eq(f(c), stf_any(c, 'a', 'e', 'i', 'o', 'u', 'A', 'E', 'I', 'O', 'U', '\xff'));
+        }
+        assert_true(f(int('a')));
+        assert_false(f(int('a') + 256));
+    }
+
+    {
+        auto f = stf_any_obj(200, 201, 204, 206, 301, 302, 304, 307, 308, 400, 404, 500, -1);
+        for (int i = -10; i < 1000; ++i)
+            assert_eq(f(i), stf_any(i, 200, 201, 204, 206, 301, 302, 304, 307, 308, 400, 404, 500, -1));
+        assert_true(f(404L));
+    }
+
+    {
+        auto f = stf_any_obj(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31,
+                             -2, -4, -6, -8, -10, -12, -14, -16, -18, -20, -22, -24, -26, -28, -30, -32,
+                             100, 200, 300, 400, 500, 600, 700, 800, 900, 1000, 1100, 1200, 1300, 1400, 1500, 1600,
+                             1 << 20, 1 << 21, 1 << 22, 1 << 23, 1 << 24, 1 << 25, 1 << 26, 1 << 27, 1 << 28, 1 << 29, 1 << 30,
+                             7, 7, 7, 7, 7);
+        const std::set<int> expected{1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31,
+                                     -2, -4, -6, -8, -10, -12, -14, -16, -18, -20, -22, -24, -26, -28, -30, -32,
+                                     100, 200, 300, 400, 500, 600, 700, 800, 900, 1000, 1100, 1200, 1300, 1400, 1500, 1600,
+                                     1 << 20, 1 << 21, 1 << 22, 1 << 23, 1 << 24, 1 << 25, 1 << 26, 1 << 27, 1 << 28, 1 << 29, 1 << 30};
+        for (int i = -100; i < 2000; ++i)
+            assert_eq(f(i), expected.count(i) == 1);
+        for (int e : expected)
+            assert_true(f(e));
+        assert_false(f(1 << 31));
+    }
+
+    {
+        std::set<int> s{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        remove_associative(s, 2, 4, 6, 8, 10, 12, 14, 16);
+        assert_eq(s, std::set<int>({1, 3, 5, 7, 9}));
+    }
+}
+
+TEST(stf_any_obj_literals_no_allocation)
+{
+    const std::string text = "1,2;3|4:5 6\t7/8\\9";
+    const u64 before = allocation_count();
+    u64 fields = 0, matches = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        // 64 literals, the largest sets are built inside the predicate as well
+        auto f = stf_any_obj(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31,
+                             33, 35, 37, 39, 41, 43, 45, 47, 49, 51, 53, 55, 57, 59, 61, 63,
+                             65, 67, 69, 71, 73, 75, 77, 79, 81, 83, 85, 87, 89, 91, 93, 95,
+                             97, 99, 101, 103, 105, 107, 109, 111, 113, 115, 117, 119, 121, 123, 125, 127);
+        matches += f(i);
+        for (auto field : split_view(text, ',', ';', '|', ':', ' ', '\t', '/', '\\'))
+            fields += !field.empty();
+    }
+    assert_eq(allocation_count(), before);
+    assert_eq(matches, 50u);
+    assert_eq(fields, 900u);
+}
@@ -0,0 +1,269 @@
+#pragma once
+#include <new>
+
+#include "span.hpp"
+
+namespace uf
+{
+    namespace detail
+    {
+        template<typename Tp, u64 Align>
+        constexpr bool check_alignment_arguments() noexcept
+        {
+            static_assert (Align && !(Align & (Align - 1)), "Alignment must be a power of two");
+            static_assert (Align >= alignof(Tp), "Alignment must be at least that of the element type");
+            static_assert (Align % sizeof(Tp) == 0, "Alignment must be a whole number of elements so padding fills whole vectors");
+            return true;
+        }
+
+        // Elements in n rounded up to whole Align-byte vectors
+        template<typename Tp, u64 Align>
+        constexpr u64 padded_count(u64 n) noexcept
+        {
+            constexpr u64 vector_size = Align / sizeof(Tp);
+            return (n + vector_size - 1) / vector_size * vector_size;
+        }
+    }
+    // namespace detail
+
+    inline namespace aligned
+    {
+        // Span whose data is known to be Align-byte aligned: data() tells the compiler so, and vector kernels need
+        // neither unaligned loads nor a peeling loop. The alignment is checked when the span is built.
+        template<typename Tp, u64 Align>
+        class aligned_span
+        {
+            static_assert (detail::check_alignment_arguments<Tp, Align>());
+
+        public:
+            using value_type = Tp;
+            using pointer = value_type*;
+            using reference = value_type&;
+            using iterator = pointer;
+
+            static constexpr u64 alignment = Align;
+
+            // Elements per Align-byte vector, the step of kernels over padded buffers
+            static constexpr u64 vector_size = Align / sizeof(Tp);
+
+        private:
+            pointer m_data = nullptr;
+            u64 m_size = 0;
+
+        public:
+            constexpr aligned_span() noexcept = default;
+
+            // Throws std::invalid_argument if data is not Align-byte aligned
+            aligned_span(pointer data, u64 count) : m_data(data), m_size(count)
+            {
+                if (reinterpret_cast<std::uintptr_t>(data) % Align)
+                    throw std::invalid_argument("aligned_span::aligned_span: Pointer is not " + std::to_string(Align) + "-byte aligned");
+            }
+
+            // From a span with at least the same alignment, e.g. an aligned_span of non-const elements
+            template<typename Up, u64 A, typename = std::enable_if_t<(A >= Align) && std::is_convertible_v<Up(*)[], Tp(*)[]>>>
+            constexpr aligned_span(const aligned_span<Up, A>& other) noexcept : m_data(other.data()), m_size(other.size()) { }
+
+            pointer data() const noexcept
+            {
+                return static_cast<pointer>(__builtin_assume_aligned(m_data, Align));
+            }
+
+            constexpr u64 size() const noexcept
+            {
+                return m_size;
+            }
+
+            constexpr bool empty() const noexcept
+            {
+                return !m_size;
+            }
+
+            reference operator[](u64 i) const noexcept
+            {
+                return data()[i];
+            }
+
+            iterator begin() const noexcept
+            {
+                return data();
+            }
+
+            iterator end() const noexcept
+            {
+                return data() + m_size;
+            }
+
+            // The first count elements keep the alignment
+            aligned_span first(u64 count) const noexcept
+            {
+                return aligned_span(m_data, std::min(count, m_size), 0);
+            }
+
+            span<Tp> view() const noexcept
+            {
+                return span<Tp>(data(), m_size);
+            }
+
+        private:
+            // Unchecked, for views derived from an aligned pointer
+            constexpr aligned_span(pointer data, u64 count, int) noexcept : m_data(data), m_size(count) { }
+
+            template<typename Up, u64 A>
+            friend class aligned_buffer;
+        };
+
+        // Owning array of trivially copyable elements on an Align-byte boundary. Storage is rounded up to whole
+        // Align-byte vectors and the padding is zeroed, so kernels may process padded() to the end without a scalar
+        // tail and reductions over it are unaffected by the padding as long as zero is neutral.
+        template<typename Tp, u64 Align>
+        class aligned_buffer
+        {
+            static_assert (detail::check_alignment_arguments<Tp, Align>());
+            static_assert (std::is_trivially_copyable_v<Tp>, "aligned_buffer holds trivially copyable elements only");
+
+            Tp* m_data = nullptr;
+            u64 m_size = 0;
+
+            static Tp* allocate(u64 padded)
+            {
+                if (!padded)
+                    return nullptr;
+                Tp* result = static_cast<Tp*>(::operator new(padded * sizeof(Tp), std::align_val_t(Align)));
+                std::memset(static_cast<void*>(result), 0, padded * sizeof(Tp));
+                return result;
+            }
+
+            static void deallocate(Tp* p) noexcept
+            {
+                if (p)
+                    ::operator delete(p, std::align_val_t(Align));
+            }
+
+        public:
+            using value_type = Tp;
+            using pointer = value_type*;
+            using const_pointer = const value_type*;
+            using iterator = pointer;
+            using const_iterator = const_pointer;
+
+            static constexpr u64 alignment = Align;
+
+            static constexpr u64 vector_size = Align / sizeof(Tp);
+
+            aligned_buffer() noexcept = default;
+
+            // count zeroed elements
+            explicit aligned_buffer(u64 count) : m_data(allocate(detail::padded_count<Tp, Align>(count))), m_size(count) { }
+
+            explicit aligned_buffer(span<const Tp> values) : aligned_buffer(values.size())
+            {
+                if (!values.empty())
+                    std::memcpy(static_cast<void*>(m_data), values.data(), values.size() * sizeof(Tp));
+            }
+
+            aligned_buffer(const aligned_buffer& other) : aligned_buffer(span<const Tp>(other.m_data, other.m_size)) { }
+
+            aligned_buffer(aligned_buffer&& other) noexcept : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) { }
+
+            aligned_buffer& operator=(aligned_buffer other) noexcept
+            {
+                std::swap(m_data, other.m_data);
+                std::swap(m_size, other.m_size);
+                return *this;
+            }
+
+            ~aligned_buffer()
+            {
+                deallocate(m_data);
+            }
+
+            u64 size() const noexcept
+            {
+                return m_size;
+            }
+
+            // Elements including the padding, a whole number of vectors
+            u64 padded_size() const noexcept
+            {
+                return detail::padded_count<Tp, Align>(m_size);
+            }
+
+            bool empty() const noexcept
+            {
+                return !m_size;
+            }
+
+            pointer data() noexcept
+            {
+                return static_cast<pointer>(__builtin_assume_aligned(m_data, Align));
+            }
+
+            const_pointer data() const noexcept
+            {
+                return static_cast<const_pointer>(__builtin_assume_aligned(m_data, Align));
+            }
+
+            Tp& operator[](u64 i) noexcept
+            {
+                return data()[i];
+            }
+
+            const Tp& operator[](u64 i) const noexcept
+            {
+                return data()[i];
+            }
+
+            iterator begin() noexcept
+            {
+                return data();
+            }
+
+            iterator end() noexcept
+            {
+                return data() + m_size;
+            }
+
+            const_iterator begin() const noexcept
+            {
+                return data();
+            }
+
+            const_iterator end() const noexcept
+            {
+                return data() + m_size;
+            }
+
+            // The elements, without the padding
+            aligned_span<Tp, Align> view() noexcept
+            {
+                return aligned_span<Tp, Align>(m_data, m_size, 0);
+            }
+
+            aligned_span<const Tp, Align> view() const noexcept
+            {
+                return aligned_span<const Tp, Align>(m_data, m_size, 0);
+            }
+
+            // The elements and the padding, writes to the padding are allowed and never read back as elements
+            aligned_span<Tp, Align> padded() noexcept
+            {
+                return aligned_span<Tp, Align>(m_data, padded_size(), 0);
+            }
+
+            aligned_span<const Tp, Align> padded() const noexcept
+            {
+                return aligned_span<const Tp, Align>(m_data, padded_size(), 0);
+            }
+
+            // Zeroes the padding again, e.g. after a kernel wrote to it
+            void clear_padding() noexcept
+            {
+                if (padded_size() > m_size)
+                    std::memset(static_cast<void*>(m_data + m_size), 0, (padded_size() - m_size) * sizeof(Tp));
+            }
+        };
+    }
+    // inline namespace aligned
+}
+// namespace uf
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+
+#include "span.hpp"
+
+namespace uf
+{
+    inline namespace arena
+    {
+        // Bump allocator over a list of blocks, reset() keeps every block so a steady-state workload stops allocating
+        class monotonic_arena
+        {
+        public:
+            static constexpr u64 default_block_size = 64 * 1024;
+
+        private:
+            struct block
+            {
+                std::unique_ptr<std::byte[]> memory;
+                u64 size;
+            };
+
+            std::vector<block> m_blocks;
+            u64 m_block_size;
+            u64 m_current = 0;
+            u64 m_offset = 0;
+
+        public:
+            explicit monotonic_arena(u64 block_size = default_block_size) : m_block_size(block_size) { }
+
+            monotonic_arena(const monotonic_arena&) = delete;
+            monotonic_arena(monotonic_arena&&) noexcept = default;
+
+            monotonic_arena& operator=(const monotonic_arena&) = delete;
+            monotonic_arena& operator=(monotonic_arena&&) noexcept = default;
+
+            void* allocate(u64 size, u64 align = alignof(std::max_align_t))
+            {
+                for (;; ++m_current, m_offset = 0)
+                {
+                    if (m_current == m_blocks.size())
+                    {
+                        const u64 block_size = std::max(m_block_size, size + align);
+                        m_blocks.push_back({std::unique_ptr<std::byte[]>(new std::byte[block_size]), block_size});
+                    }
+                    block& b = m_blocks[m_current];
+                    const u64 base = reinterpret_cast<u64>(b.memory.get());
+                    const u64 begin = ((base + m_offset + align - 1) & ~(align - 1)) - base;
+                    if (begin + size <= b.size)
+                    {
+                        m_offset = begin + size;
+                        return b.memory.get() + begin;
+                    }
+                }
+            }
+
+            template<typename Tp>
+            span<Tp> allocate_array(u64 n)
+            {
+                static_assert (std::is_trivially_destructible_v<Tp>, "Arena never runs destructors");
+                return span<Tp>(static_cast<Tp*>(allocate(n * sizeof(Tp), alignof(Tp))), n);
+            }
+
+            std::string_view store(std::string_view s)
+            {
+                if (s.empty())
+                    return std::string_view();
+                char* result = allocate_array<char>(s.size()).data();
+                std::memcpy(result, s.data(), s.size());
+                return std::string_view(result, s.size());
+            }
+
+            template<typename Tp>
+            span<const Tp> store(span<const Tp> s)
+            {
+                static_assert (std::is_trivially_copyable_v<Tp>, "Arena stores only trivially copyable values");
+                if (s.empty())
+                    return span<const Tp>();
+                Tp* result = allocate_array<Tp>(s.size()).data();
+                std::memcpy(result, s.data(), s.size() * sizeof(Tp));
+                return span<const Tp>(result, s.size());
+            }
+
+            // Forgets every allocation but keeps the memory for reuse
+            void reset() noexcept
+            {
+                m_current = 0;
+                m_offset = 0;
+            }
+
+            // Returns the memory to the system
+            void release() noexcept
+            {
+                m_blocks.clear();
+                reset();
+            }
+
+            u64 capacity() const noexcept
+            {
+                u64 result = 0;
+                for (const auto& b : m_blocks)
+                    result += b.size;
+                return result;
+            }
+        };
+    }
+    // inline namespace arena
+}
+// namespace uf
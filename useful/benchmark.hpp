@@ -6,6 +6,10 @@
 
 #include "base.hpp"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 
 namespace uf
 {
@@ -59,7 +63,7 @@ namespace uf
             }
         };
 
-        auto create_tm()
+        inline auto create_tm()
         {
             using tm_type = time_meter<std::chrono::high_resolution_clock::time_point>;
 
@@ -71,7 +75,7 @@ namespace uf
             return tm_type(std::chrono::high_resolution_clock::now, get_sec);
         }
 
-        auto create_proc_tm()
+        inline auto create_proc_tm()
         {
             using tm_type = time_meter<clock_t>;
 
@@ -103,6 +107,21 @@ namespace uf
             std::invoke(f, std::forward<Args>(args)...);
             return tm.seconds();
         }
+
+        // Reference cycles (TSC ticks) spent in f, falls back to nanoseconds where there is no TSC
+        template<typename F, typename... Args>
+        u64 cycle_benchmark(F&& f, Args&&... args)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            const u64 begin = __rdtsc();
+            std::invoke(f, std::forward<Args>(args)...);
+            return __rdtsc() - begin;
+#else
+            const auto begin = std::chrono::steady_clock::now();
+            std::invoke(f, std::forward<Args>(args)...);
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+#endif
+        }
     }
     // inline namespace benchmark
 }
@@ -0,0 +1,245 @@
+#pragma once
+#include "strings.hpp"
+
+namespace uf
+{
+    inline namespace builder
+    {
+        // Free list of fixed-size chunks shared by string builders. Not thread-safe, it must outlive the builders
+        // that use it.
+        class chunk_pool
+        {
+        public:
+            static constexpr u64 default_chunk_size = 64 * 1024;
+
+        private:
+            u64 m_chunk_size;
+            std::vector<std::unique_ptr<char[]>> m_free;
+
+        public:
+            explicit chunk_pool(u64 chunk_size = default_chunk_size) : m_chunk_size(chunk_size)
+            {
+                if (!chunk_size)
+                    throw std::invalid_argument("chunk_pool: Chunk size must be positive");
+            }
+
+            chunk_pool(const chunk_pool&) = delete;
+            chunk_pool& operator=(const chunk_pool&) = delete;
+
+            u64 chunk_size() const noexcept
+            {
+                return m_chunk_size;
+            }
+
+            // A released chunk if there is one, a new one otherwise
+            std::unique_ptr<char[]> acquire()
+            {
+                if (m_free.empty())
+                    return std::unique_ptr<char[]>(new char[m_chunk_size]);
+                std::unique_ptr<char[]> result = std::move(m_free.back());
+                m_free.pop_back();
+                return result;
+            }
+
+            void release(std::unique_ptr<char[]> chunk)
+            {
+                m_free.push_back(std::move(chunk));
+            }
+
+            // Chunks waiting for reuse
+            u64 free_count() const noexcept
+            {
+                return m_free.size();
+            }
+        };
+
+        // Text assembled from many appends without reallocation or copying of what is already written. Appends fill
+        // fixed-size chunks taken from a pool, append_view adds external text by reference. The text is exposed as
+        // a sequence of pieces that can go to writev as is, and is only joined into one string when asked.
+        class string_builder
+        {
+            // Builders without a shared pool create their own on the first chunk
+            u64 m_chunk_size;
+            std::unique_ptr<chunk_pool> m_own_pool;
+            chunk_pool* m_pool = nullptr;
+            std::vector<std::unique_ptr<char[]>> m_chunks;
+            std::vector<span<const char>> m_pieces;
+            char* m_cursor = nullptr;
+            char* m_end = nullptr;
+            u64 m_size = 0;
+
+            void next_chunk()
+            {
+                if (!m_pool)
+                {
+                    m_own_pool = std::make_unique<chunk_pool>(m_chunk_size);
+                    m_pool = m_own_pool.get();
+                }
+                m_chunks.push_back(m_pool->acquire());
+                m_cursor = m_chunks.back().get();
+                m_end = m_cursor + m_pool->chunk_size();
+            }
+
+            // Extends the last piece if it ends at the cursor, written text stays one piece per chunk
+            void commit(u64 n)
+            {
+                if (!m_pieces.empty() && m_pieces.back().data() + m_pieces.back().size() == m_cursor)
+                    m_pieces.back() = span<const char>(m_pieces.back().data(), m_pieces.back().size() + n);
+                else
+                    m_pieces.emplace_back(m_cursor, n);
+                m_cursor += n;
+                m_size += n;
+            }
+
+            void append_bytes(const char* p, u64 n)
+            {
+                while (n)
+                {
+                    if (m_cursor == m_end)
+                        next_chunk();
+                    const u64 step = std::min<u64>(n, m_end - m_cursor);
+                    std::memcpy(m_cursor, p, step);
+                    commit(step);
+                    p += step;
+                    n -= step;
+                }
+            }
+
+            template<typename Tp>
+            void append_part(const Tp& part)
+            {
+                if constexpr (std::is_arithmetic_v<Tp>)
+                {
+                    // Numbers are short and written in place, they never straddle chunks
+                    const u64 n = detail::text_size(part);
+                    if (static_cast<u64>(m_end - m_cursor) < n)
+                        next_chunk();
+                    detail::write_text(m_cursor, part);
+                    commit(n);
+                }
+                else
+                {
+                    const std::string_view view(part);
+                    append_bytes(view.data(), view.size());
+                }
+            }
+
+        public:
+            explicit string_builder(u64 chunk_size = chunk_pool::default_chunk_size) : m_chunk_size(chunk_size)
+            {
+                if (chunk_size < 64)
+                    throw std::invalid_argument("string_builder: Chunks must hold at least 64 chars");
+            }
+
+            // Chunks come from pool and go back to it on clear and destruction
+            explicit string_builder(chunk_pool& pool) : m_chunk_size(pool.chunk_size()), m_pool(&pool)
+            {
+                if (pool.chunk_size() < 64)
+                    throw std::invalid_argument("string_builder: Chunks must hold at least 64 chars");
+            }
+
+            string_builder(const string_builder&) = delete;
+            // The moved-from builder is empty and keeps a shared pool, an owned one moves with the chunks
+            string_builder(string_builder&& other) noexcept :
+                m_chunk_size(other.m_chunk_size),
+                m_own_pool(std::move(other.m_own_pool)),
+                m_pool(m_own_pool ? std::exchange(other.m_pool, nullptr) : other.m_pool),
+                m_chunks(std::move(other.m_chunks)),
+                m_pieces(std::move(other.m_pieces)),
+                m_cursor(std::exchange(other.m_cursor, nullptr)),
+                m_end(std::exchange(other.m_end, nullptr)),
+                m_size(std::exchange(other.m_size, 0))
+            {
+                other.m_chunks.clear();
+                other.m_pieces.clear();
+            }
+
+            string_builder& operator=(const string_builder&) = delete;
+            string_builder& operator=(string_builder&&) = delete;
+
+            ~string_builder()
+            {
+                clear();
+            }
+
+            // Parts are chars, strings, string views and numbers, as for concat
+            template<typename... Parts>
+            string_builder& append(const Parts&... parts)
+            {
+                (append_part(parts), ...);
+                return *this;
+            }
+
+            // Adds text by reference without copying, it must stay alive and unchanged while the builder is used
+            string_builder& append_view(std::string_view s)
+            {
+                if (!s.empty())
+                {
+                    m_pieces.emplace_back(s.data(), s.size());
+                    m_size += s.size();
+                }
+                return *this;
+            }
+
+            template<typename Tp>
+            string_builder& operator<<(const Tp& part)
+            {
+                append_part(part);
+                return *this;
+            }
+
+            u64 size() const noexcept
+            {
+                return m_size;
+            }
+
+            bool empty() const noexcept
+            {
+                return !m_size;
+            }
+
+            // The text in order as non-empty pieces, for writev or any other gather output. Valid until the next
+            // modification of the builder.
+            span<const span<const char>> pieces() const noexcept
+            {
+                return span<const span<const char>>(m_pieces.data(), m_pieces.size());
+            }
+
+            // Copies the text into out, returns the number of chars written or 0 if out is too small
+            u64 copy_to(span<char> out) const noexcept
+            {
+                if (out.size() < m_size)
+                    return 0;
+                char* p = out.data();
+                for (const auto& piece : m_pieces)
+                {
+                    std::memcpy(p, piece.data(), piece.size());
+                    p += piece.size();
+                }
+                return m_size;
+            }
+
+            // The joined text, allocated once
+            std::string str() const
+            {
+                std::string result(m_size, '\0');
+                copy_to(span<char>(result));
+                return result;
+            }
+
+            // Forgets the text and returns the chunks to the pool
+            void clear()
+            {
+                for (auto& chunk : m_chunks)
+                    if (chunk)
+                        m_pool->release(std::move(chunk));
+                m_chunks.clear();
+                m_pieces.clear();
+                m_cursor = m_end = nullptr;
+                m_size = 0;
+            }
+        };
+    }
+    // inline namespace builder
+}
+// namespace uf
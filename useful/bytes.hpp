@@ -0,0 +1,456 @@
+#pragma once
+#include "span.hpp"
+
+namespace uf
+{
+    namespace detail
+    {
+        // Longest LEB128 encoding of a u64
+        inline constexpr u64 varint_max_size = 10;
+
+        template<typename Tp>
+        inline constexpr bool is_wire_value_v = (std::is_integral_v<Tp> || std::is_enum_v<Tp> || std::is_floating_point_v<Tp>) && !std::is_same_v<Tp, bool> &&
+                                                (sizeof(Tp) == 1 || sizeof(Tp) == 2 || sizeof(Tp) == 4 || sizeof(Tp) == 8);
+
+        template<u64 Size>
+        using wire_uint = std::conditional_t<Size == 1, u8, std::conditional_t<Size == 2, u16, std::conditional_t<Size == 4, u32, u64>>>;
+
+        template<typename Up>
+        Up byte_swap(Up v) noexcept
+        {
+            if constexpr (sizeof(Up) == 1)
+                return v;
+            else if constexpr (sizeof(Up) == 2)
+                return __builtin_bswap16(v);
+            else if constexpr (sizeof(Up) == 4)
+                return __builtin_bswap32(v);
+            else
+                return __builtin_bswap64(v);
+        }
+
+        // memcpy of a constant size plus an optional byte swap, compilers emit a single mov or mov + bswap
+        template<typename Tp, bool Swap>
+        Tp load(const std::byte* p) noexcept
+        {
+            static_assert (is_wire_value_v<Tp>, "Only integers, enums and floats of 1, 2, 4 or 8 bytes can be loaded");
+            wire_uint<sizeof(Tp)> bits;
+            std::memcpy(&bits, p, sizeof(bits));
+            if constexpr (Swap)
+                bits = byte_swap(bits);
+            Tp result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        template<typename Tp, bool Swap>
+        void store(std::byte* p, Tp value) noexcept
+        {
+            static_assert (is_wire_value_v<Tp>, "Only integers, enums and floats of 1, 2, 4 or 8 bytes can be stored");
+            wire_uint<sizeof(Tp)> bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            if constexpr (Swap)
+                bits = byte_swap(bits);
+            std::memcpy(p, &bits, sizeof(bits));
+        }
+
+        // LEB128 from p with at least limit readable bytes, 0 on truncation or an overlong encoding
+        inline u64 load_varint(const std::byte* p, u64 limit, u64& value) noexcept
+        {
+            u64 result = 0;
+            for (u64 i = 0; i < std::min(limit, varint_max_size); ++i)
+            {
+                const u64 b = static_cast<u8>(p[i]);
+                // The tenth byte holds the top bit only
+                if (i == varint_max_size - 1 && b > 1)
+                    return 0;
+                result |= (b & 0x7f) << (7 * i);
+                if (b < 0x80)
+                {
+                    value = result;
+                    return i + 1;
+                }
+            }
+            return 0;
+        }
+
+        inline u64 varint_size(u64 v) noexcept
+        {
+            return 1 + (63 - __builtin_clzll(v | 1)) / 7;
+        }
+
+        inline u64 store_varint(std::byte* p, u64 v) noexcept
+        {
+            u64 i = 0;
+            for (; v >= 0x80; v >>= 7)
+                p[i++] = static_cast<std::byte>(v | 0x80);
+            p[i++] = static_cast<std::byte>(v);
+            return i;
+        }
+
+        inline u64 zigzag_encode(i64 v) noexcept
+        {
+            return (static_cast<u64>(v) << 1) ^ static_cast<u64>(v >> 63);
+        }
+
+        inline i64 zigzag_decode(u64 v) noexcept
+        {
+            return static_cast<i64>(v >> 1) ^ -static_cast<i64>(v & 1);
+        }
+    }
+    // namespace detail
+
+    inline namespace bytes
+    {
+        enum class byte_order : u8
+        {
+            little,
+            big
+        };
+
+        inline constexpr byte_order native_order = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ ? byte_order::little : byte_order::big;
+
+        // Unaligned loads of integers, enums and floats in either byte order
+        template<typename Tp, byte_order Order = byte_order::little>
+        Tp load(span<const std::byte, sizeof(Tp)> bytes) noexcept
+        {
+            return detail::load<Tp, Order != native_order>(bytes.data());
+        }
+
+        template<typename Tp, byte_order Order = byte_order::little>
+        void store(span<std::byte, sizeof(Tp)> bytes, Tp value) noexcept
+        {
+            detail::store<Tp, Order != native_order>(bytes.data(), value);
+        }
+
+        // Cursor over a byte buffer for binary formats. Every read checks that the field fits and throws
+        // std::out_of_range otherwise. For records of several fields, read_fields checks once for all of them, and
+        // after require(n) the *_unchecked reads skip the check for the next n bytes. Byte order is a template
+        // argument, little endian by default.
+        class byte_reader
+        {
+            const std::byte* m_begin;
+            const std::byte* m_cursor;
+            const std::byte* m_end;
+
+            // Static so the cursor never escapes and stays in registers on the fast path
+            [[noreturn]] static void underrun(const char* what, u64 n, u64 position, u64 remaining)
+            {
+                throw std::out_of_range(std::string("byte_reader::") + what + ": " + std::to_string(n) + " bytes needed at offset " +
+                                        std::to_string(position) + ", " + std::to_string(remaining) + " left");
+            }
+
+            u64 read_varint_checked()
+            {
+                u64 value = 0;
+                const u64 n = detail::load_varint(m_cursor, remaining(), value);
+                if (!n)
+                {
+                    if (remaining() >= detail::varint_max_size)
+                        throw std::invalid_argument("byte_reader::read_varint: Overlong varint at offset " + std::to_string(position()));
+                    underrun("read_varint", remaining() + 1, position(), remaining());
+                }
+                m_cursor += n;
+                return value;
+            }
+
+        public:
+            explicit byte_reader(span<const std::byte> data) noexcept : m_begin(data.data()), m_cursor(data.data()), m_end(data.data() + data.size()) { }
+
+            u64 position() const noexcept
+            {
+                return m_cursor - m_begin;
+            }
+
+            u64 remaining() const noexcept
+            {
+                return m_end - m_cursor;
+            }
+
+            bool empty() const noexcept
+            {
+                return m_cursor == m_end;
+            }
+
+            // Whether n more bytes can be read
+            bool can_read(u64 n) const noexcept
+            {
+                return n <= remaining();
+            }
+
+            // Throws unless n more bytes can be read
+            void require(u64 n) const
+            {
+                if (!can_read(n))
+                    underrun("require", n, position(), remaining());
+            }
+
+            void seek(u64 offset)
+            {
+                if (offset > static_cast<u64>(m_end - m_begin))
+                    throw std::out_of_range("byte_reader::seek: Offset " + std::to_string(offset) + " is past the end");
+                m_cursor = m_begin + offset;
+            }
+
+            void skip(u64 n)
+            {
+                require(n);
+                m_cursor += n;
+            }
+
+            template<typename Tp, byte_order Order = byte_order::little>
+            Tp read_unchecked() noexcept
+            {
+                const Tp result = detail::load<Tp, Order != native_order>(m_cursor);
+                m_cursor += sizeof(Tp);
+                return result;
+            }
+
+            template<typename Tp, byte_order Order = byte_order::little>
+            Tp read()
+            {
+                if (!can_read(sizeof(Tp)))
+                    underrun("read", sizeof(Tp), position(), remaining());
+                return read_unchecked<Tp, Order>();
+            }
+
+            template<typename Tp>
+            Tp read_le()
+            {
+                return read<Tp, byte_order::little>();
+            }
+
+            template<typename Tp>
+            Tp read_be()
+            {
+                return read<Tp, byte_order::big>();
+            }
+
+            // Consecutive fields into the given variables with one bounds check
+            template<byte_order Order = byte_order::little, typename... Ts>
+            void read_fields(Ts&... fields)
+            {
+                constexpr u64 size = (sizeof(Ts) + ... + 0);
+                if (!can_read(size))
+                    underrun("read_fields", size, position(), remaining());
+                ((fields = read_unchecked<Ts, Order>()), ...);
+            }
+
+            // A view of the next n bytes, nothing is copied
+            span<const std::byte> read_bytes(u64 n)
+            {
+                if (!can_read(n))
+                    underrun("read_bytes", n, position(), remaining());
+                const span<const std::byte> result(m_cursor, n);
+                m_cursor += n;
+                return result;
+            }
+
+            // Unsigned LEB128 as in protobuf, throws std::invalid_argument on encodings longer than 10 bytes. Away
+            // from the end of the buffer the bytes are read without checks, like the hand-written loop.
+            u64 read_varint()
+            {
+                if (can_read(detail::varint_max_size))
+                {
+                    // Lengths and counts are mostly one or two bytes
+                    const u64 b0 = static_cast<u8>(m_cursor[0]);
+                    if (b0 < 0x80)
+                    {
+                        ++m_cursor;
+                        return b0;
+                    }
+                    const u64 b1 = static_cast<u8>(m_cursor[1]);
+                    if (b1 < 0x80)
+                    {
+                        m_cursor += 2;
+                        return (b0 & 0x7f) | b1 << 7;
+                    }
+                    u64 value = 0;
+                    // The tenth byte needs the overflow check of the general path
+                    for (u64 i = 0; i + 1 < detail::varint_max_size; ++i)
+                    {
+                        const u64 b = static_cast<u8>(m_cursor[i]);
+                        value |= (b & 0x7f) << (7 * i);
+                        if (b < 0x80)
+                        {
+                            m_cursor += i + 1;
+                            return value;
+                        }
+                    }
+                }
+                return read_varint_checked();
+            }
+
+            // Zigzag-encoded signed varint
+            i64 read_varint_signed()
+            {
+                return detail::zigzag_decode(read_varint());
+            }
+
+            // Text preceded by its length as a Length integer, the view points into the buffer
+            template<typename Length = u32, byte_order Order = byte_order::little>
+            std::string_view read_string()
+            {
+                static_assert (std::is_integral_v<Length> && std::is_unsigned_v<Length>, "The length prefix must be an unsigned integer");
+                const auto start = m_cursor;
+                const u64 n = read<Length, Order>();
+                if (!can_read(n))
+                {
+                    m_cursor = start;
+                    underrun("read_string", sizeof(Length) + n, position(), remaining());
+                }
+                const std::string_view result(reinterpret_cast<const char*>(m_cursor), n);
+                m_cursor += n;
+                return result;
+            }
+
+            // Text preceded by its length as a varint
+            std::string_view read_varint_string()
+            {
+                const auto start = m_cursor;
+                const u64 n = read_varint();
+                if (!can_read(n))
+                {
+                    const u64 prefix = m_cursor - start;
+                    m_cursor = start;
+                    underrun("read_varint_string", prefix + n, position(), remaining());
+                }
+                const std::string_view result(reinterpret_cast<const char*>(m_cursor), n);
+                m_cursor += n;
+                return result;
+            }
+        };
+
+        // Cursor that fills a caller-provided byte buffer, the write counterpart of byte_reader. Writes that do not
+        // fit throw std::out_of_range and write nothing.
+        class byte_writer
+        {
+            std::byte* m_begin;
+            std::byte* m_cursor;
+            std::byte* m_end;
+
+            // Static so the cursor never escapes and stays in registers on the fast path
+            [[noreturn]] static void overrun(const char* what, u64 n, u64 position, u64 remaining)
+            {
+                throw std::out_of_range(std::string("byte_writer::") + what + ": " + std::to_string(n) + " bytes needed at offset " +
+                                        std::to_string(position) + ", " + std::to_string(remaining) + " left");
+            }
+
+        public:
+            explicit byte_writer(span<std::byte> out) noexcept : m_begin(out.data()), m_cursor(out.data()), m_end(out.data() + out.size()) { }
+
+            u64 position() const noexcept
+            {
+                return m_cursor - m_begin;
+            }
+
+            u64 remaining() const noexcept
+            {
+                return m_end - m_cursor;
+            }
+
+            bool can_write(u64 n) const noexcept
+            {
+                return n <= remaining();
+            }
+
+            void require(u64 n) const
+            {
+                if (!can_write(n))
+                    overrun("require", n, position(), remaining());
+            }
+
+            // The bytes written so far
+            span<std::byte> written() const noexcept
+            {
+                return span<std::byte>(m_begin, m_cursor);
+            }
+
+            template<typename Tp, byte_order Order = byte_order::little>
+            void write_unchecked(Tp value) noexcept
+            {
+                detail::store<Tp, Order != native_order>(m_cursor, value);
+                m_cursor += sizeof(Tp);
+            }
+
+            template<typename Tp, byte_order Order = byte_order::little>
+            void write(Tp value)
+            {
+                if (!can_write(sizeof(Tp)))
+                    overrun("write", sizeof(Tp), position(), remaining());
+                write_unchecked<Tp, Order>(value);
+            }
+
+            template<typename Tp>
+            void write_le(Tp value)
+            {
+                write<Tp, byte_order::little>(value);
+            }
+
+            template<typename Tp>
+            void write_be(Tp value)
+            {
+                write<Tp, byte_order::big>(value);
+            }
+
+            // Consecutive fields with one bounds check, the types are taken as given so pass the exact widths
+            template<byte_order Order = byte_order::little, typename... Ts>
+            void write_fields(const Ts&... fields)
+            {
+                constexpr u64 size = (sizeof(Ts) + ... + 0);
+                if (!can_write(size))
+                    overrun("write_fields", size, position(), remaining());
+                (write_unchecked<Ts, Order>(fields), ...);
+            }
+
+            void write_bytes(span<const std::byte> data)
+            {
+                if (!can_write(data.size()))
+                    overrun("write_bytes", data.size(), position(), remaining());
+                if (!data.empty())
+                    std::memcpy(m_cursor, data.data(), data.size());
+                m_cursor += data.size();
+            }
+
+            void write_varint(u64 value)
+            {
+                const u64 n = detail::varint_size(value);
+                if (!can_write(n))
+                    overrun("write_varint", n, position(), remaining());
+                m_cursor += detail::store_varint(m_cursor, value);
+            }
+
+            void write_varint_signed(i64 value)
+            {
+                write_varint(detail::zigzag_encode(value));
+            }
+
+            // Throws std::length_error if the length does not fit in Length
+            template<typename Length = u32, byte_order Order = byte_order::little>
+            void write_string(std::string_view s)
+            {
+                static_assert (std::is_integral_v<Length> && std::is_unsigned_v<Length>, "The length prefix must be an unsigned integer");
+                if (s.size() > std::numeric_limits<Length>::max())
+                    throw std::length_error("byte_writer::write_string: Length " + std::to_string(s.size()) + " does not fit the prefix");
+                if (!can_write(sizeof(Length) + s.size()))
+                    overrun("write_string", sizeof(Length) + s.size(), position(), remaining());
+                write_unchecked<Length, Order>(static_cast<Length>(s.size()));
+                if (!s.empty())
+                    std::memcpy(m_cursor, s.data(), s.size());
+                m_cursor += s.size();
+            }
+
+            void write_varint_string(std::string_view s)
+            {
+                const u64 n = detail::varint_size(s.size()) + s.size();
+                if (!can_write(n))
+                    overrun("write_varint_string", n, position(), remaining());
+                m_cursor += detail::store_varint(m_cursor, s.size());
+                if (!s.empty())
+                    std::memcpy(m_cursor, s.data(), s.size());
+                m_cursor += s.size();
+            }
+        };
+    }
+    // inline namespace bytes
+}
+// namespace uf
@@ -0,0 +1,345 @@
+#pragma once
+#include "span.hpp"
+
+namespace uf
+{
+    namespace detail
+    {
+        // Dynamic span over any contiguous container or span, rvalue containers would dangle
+        template<class C>
+        auto dynamic_span(C&& c)
+        {
+            static_assert (std::is_lvalue_reference_v<C> || mt::is_span_v<std::decay_t<C>>, "Attempt to create a view from rvalue");
+            return span<std::remove_pointer_t<decltype(c.data())>>(c.data(), c.size());
+        }
+
+        inline void check_chunk_size(u64 k, const char* what)
+        {
+            if (!k)
+                throw std::invalid_argument(std::string(what) + ": Size must be positive");
+        }
+
+        // Random access iterator over the sub-spans of View by index. Sub-spans are made on dereference, so
+        // reference is the span itself rather than a reference to one. Views are a span and a size, the iterator
+        // keeps a copy and stays valid after the view it came from is gone. Views are default constructible as
+        // empty ones for default-constructed iterators.
+        template<class View>
+        class sub_span_iterator
+        {
+            View m_view;
+            u64 m_index = 0;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = typename View::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            sub_span_iterator() noexcept = default;
+
+            sub_span_iterator(const View& view, u64 index) noexcept : m_view(view), m_index(index) { }
+
+            value_type operator*() const noexcept
+            {
+                return m_view[m_index];
+            }
+
+            value_type operator[](difference_type n) const noexcept
+            {
+                return m_view[m_index + n];
+            }
+
+            sub_span_iterator& operator++() noexcept
+            {
+                ++m_index;
+                return *this;
+            }
+
+            sub_span_iterator operator++(int) noexcept
+            {
+                auto result = *this;
+                ++m_index;
+                return result;
+            }
+
+            sub_span_iterator& operator--() noexcept
+            {
+                --m_index;
+                return *this;
+            }
+
+            sub_span_iterator operator--(int) noexcept
+            {
+                auto result = *this;
+                --m_index;
+                return result;
+            }
+
+            sub_span_iterator& operator+=(difference_type n) noexcept
+            {
+                m_index += n;
+                return *this;
+            }
+
+            sub_span_iterator& operator-=(difference_type n) noexcept
+            {
+                m_index -= n;
+                return *this;
+            }
+
+            sub_span_iterator operator+(difference_type n) const noexcept
+            {
+                return sub_span_iterator(m_view, m_index + n);
+            }
+
+            friend sub_span_iterator operator+(difference_type n, const sub_span_iterator& i) noexcept
+            {
+                return i + n;
+            }
+
+            sub_span_iterator operator-(difference_type n) const noexcept
+            {
+                return sub_span_iterator(m_view, m_index - n);
+            }
+
+            difference_type operator-(const sub_span_iterator& other) const noexcept
+            {
+                return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index);
+            }
+
+            bool operator==(const sub_span_iterator& other) const noexcept
+            {
+                return m_index == other.m_index;
+            }
+
+            bool operator!=(const sub_span_iterator& other) const noexcept
+            {
+                return m_index != other.m_index;
+            }
+
+            bool operator<(const sub_span_iterator& other) const noexcept
+            {
+                return m_index < other.m_index;
+            }
+
+            bool operator>(const sub_span_iterator& other) const noexcept
+            {
+                return m_index > other.m_index;
+            }
+
+            bool operator<=(const sub_span_iterator& other) const noexcept
+            {
+                return m_index <= other.m_index;
+            }
+
+            bool operator>=(const sub_span_iterator& other) const noexcept
+            {
+                return m_index >= other.m_index;
+            }
+        };
+
+        // Shared interface of the views: the derived class gives size() and operator[]
+        template<class View>
+        class sub_span_range
+        {
+        public:
+            using iterator = sub_span_iterator<View>;
+
+            iterator begin() const noexcept
+            {
+                return iterator(static_cast<const View&>(*this), 0);
+            }
+
+            iterator end() const noexcept
+            {
+                return iterator(static_cast<const View&>(*this), static_cast<const View&>(*this).size());
+            }
+
+            bool empty() const noexcept
+            {
+                return !static_cast<const View&>(*this).size();
+            }
+        };
+    }
+    // namespace detail
+
+    inline namespace batching
+    {
+        // Consecutive sub-spans of k elements, the last one holds the rest and may be shorter
+        template<typename Tp>
+        class chunk_view : public detail::sub_span_range<chunk_view<Tp>>
+        {
+            span<Tp> m_data;
+            u64 m_chunk = 1;
+
+        public:
+            using value_type = span<Tp>;
+
+            chunk_view() noexcept = default;
+
+            chunk_view(span<Tp> data, u64 k) : m_data(data), m_chunk(k)
+            {
+                detail::check_chunk_size(k, "chunks");
+            }
+
+            u64 size() const noexcept
+            {
+                // Rounding up by adding k - 1 would overflow for huge k
+                return m_data.size() / m_chunk + (m_data.size() % m_chunk != 0);
+            }
+
+            span<Tp> operator[](u64 i) const noexcept
+            {
+                const u64 begin = i * m_chunk;
+                return span<Tp>(m_data.data() + begin, std::min(m_chunk, m_data.size() - begin));
+            }
+        };
+
+        // Every run of k consecutive elements, overlapping with step one. Fewer than k elements give no windows.
+        template<typename Tp>
+        class window_view : public detail::sub_span_range<window_view<Tp>>
+        {
+            span<Tp> m_data;
+            u64 m_window = 1;
+
+        public:
+            using value_type = span<Tp>;
+
+            window_view() noexcept = default;
+
+            window_view(span<Tp> data, u64 k) : m_data(data), m_window(k)
+            {
+                detail::check_chunk_size(k, "windows");
+            }
+
+            u64 size() const noexcept
+            {
+                return m_data.size() >= m_window ? m_data.size() - m_window + 1 : 0;
+            }
+
+            span<Tp> operator[](u64 i) const noexcept
+            {
+                return span<Tp>(m_data.data() + i, m_window);
+            }
+        };
+
+        // Exactly parts contiguous sub-spans whose sizes differ by at most one, the longer ones first. Parts are
+        // empty when there are fewer elements than parts, so one part per thread always works.
+        template<typename Tp>
+        class partition_view : public detail::sub_span_range<partition_view<Tp>>
+        {
+            span<Tp> m_data;
+            u64 m_parts = 1;
+
+        public:
+            using value_type = span<Tp>;
+
+            partition_view() noexcept = default;
+
+            partition_view(span<Tp> data, u64 parts) : m_data(data), m_parts(parts)
+            {
+                detail::check_chunk_size(parts, "partition");
+            }
+
+            u64 size() const noexcept
+            {
+                return m_parts;
+            }
+
+            span<Tp> operator[](u64 i) const noexcept
+            {
+                const u64 base = m_data.size() / m_parts, longer = m_data.size() % m_parts;
+                const u64 begin = i * base + std::min(i, longer);
+                return span<Tp>(m_data.data() + begin, base + (i < longer));
+            }
+        };
+
+        // Only whole chunks of K elements, what is left over is in remainder(). With a static K every chunk is a
+        // span<Tp, K>, so loops over a chunk have a constant trip count.
+        template<typename Tp, u64 K = dynamic_extent>
+        class chunk_exact_view : public detail::sub_span_range<chunk_exact_view<Tp, K>>
+        {
+            span<Tp> m_data;
+            u64 m_chunk = K == dynamic_extent ? 1 : K;
+
+        public:
+            using value_type = span<Tp, K>;
+
+            chunk_exact_view() noexcept = default;
+
+            chunk_exact_view(span<Tp> data, u64 k) : m_data(data), m_chunk(k)
+            {
+                detail::check_chunk_size(k, "chunks_exact");
+            }
+
+            u64 chunk_size() const noexcept
+            {
+                if constexpr (K == dynamic_extent)
+                    return m_chunk;
+                else
+                    return K;
+            }
+
+            u64 size() const noexcept
+            {
+                return m_data.size() / chunk_size();
+            }
+
+            value_type operator[](u64 i) const noexcept
+            {
+                if constexpr (K == dynamic_extent)
+                    return span<Tp>(m_data.data() + i * m_chunk, m_chunk);
+                else
+                    return span<Tp, K>(m_data.data() + i * K);
+            }
+
+            // The last size() % k elements, not part of any chunk
+            span<Tp> remainder() const noexcept
+            {
+                const u64 whole = size() * chunk_size();
+                return span<Tp>(m_data.data() + whole, m_data.size() - whole);
+            }
+        };
+
+        // Lazy views over a span or a contiguous container, nothing is allocated and every element is reached
+        // through sub-spans of the original storage. A size of zero throws std::invalid_argument.
+        template<class C>
+        auto chunks(C&& c, u64 k)
+        {
+            auto s = detail::dynamic_span(std::forward<C>(c));
+            return chunk_view<typename decltype(s)::value_type>(s, k);
+        }
+
+        template<class C>
+        auto windows(C&& c, u64 k)
+        {
+            auto s = detail::dynamic_span(std::forward<C>(c));
+            return window_view<typename decltype(s)::value_type>(s, k);
+        }
+
+        template<class C>
+        auto partition(C&& c, u64 parts)
+        {
+            auto s = detail::dynamic_span(std::forward<C>(c));
+            return partition_view<typename decltype(s)::value_type>(s, parts);
+        }
+
+        template<class C>
+        auto chunks_exact(C&& c, u64 k)
+        {
+            auto s = detail::dynamic_span(std::forward<C>(c));
+            return chunk_exact_view<typename decltype(s)::value_type>(s, k);
+        }
+
+        template<u64 K, class C>
+        auto chunks_exact(C&& c)
+        {
+            static_assert (K && K != dynamic_extent, "chunks_exact: Size must be positive");
+            auto s = detail::dynamic_span(std::forward<C>(c));
+            return chunk_exact_view<typename decltype(s)::value_type, K>(s, K);
+        }
+    }
+    // inline namespace batching
+}
+// namespace uf
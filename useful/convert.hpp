@@ -0,0 +1,231 @@
+#pragma once
+#include <optional>
+
+#include "span.hpp"
+#include "simd.hpp"
+
+namespace uf
+{
+    namespace detail
+    {
+        template<class Token>
+        std::string_view token_chars(const Token& token) noexcept
+        {
+            return std::string_view(std::data(token), std::size(token));
+        }
+
+        // Fixed-width fields up to this length are converted with one vector multiply-add chain
+        inline constexpr u64 fixed_digits_max = 16;
+
+        inline bool parse_digits_scalar(const char* p, u64 n, u64& value) noexcept
+        {
+            u64 result = 0;
+            for (u64 i = 0; i < n; ++i)
+            {
+                const u8 d = static_cast<u8>(p[i] - '0');
+                if (d > 9)
+                    return false;
+                result = result * 10 + d;
+            }
+            value = result;
+            return true;
+        }
+
+#ifdef UF_SIMD_X86
+        // The field is loaded as a whole block and shifted so its digits are right-aligned over zeros, then pairs,
+        // quads and octets of digits are combined with multiply-adds. Needs 16 readable bytes at p.
+        UF_TARGET("avx2") inline bool parse_digits_avx2(const char* p, u64 n, u64& value) noexcept
+        {
+            const __m128i raw = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+            const u32 bad = ~static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(raw, _mm_set1_epi8(9)), _mm_set1_epi8(9))));
+            if (bad & ((u32(1) << n) - 1))
+                return false;
+            // Negative shuffle indices have the top bit set and produce zero lanes
+            const __m128i shift = _mm_add_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm_set1_epi8(static_cast<char>(n - 16)));
+            const __m128i digits = _mm_shuffle_epi8(raw, shift);
+            const __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+            const __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+            const __m128i packed = _mm_packus_epi32(quads, quads);
+            const __m128i octets = _mm_madd_epi16(packed, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+            value = u64(static_cast<u32>(_mm_cvtsi128_si32(octets))) * 100000000 + static_cast<u32>(_mm_extract_epi32(octets, 1));
+            return true;
+        }
+#endif
+
+        template<typename Tp>
+        std::errc signed_magnitude(u64 magnitude, bool negative, Tp& value) noexcept
+        {
+            using unsigned_type = std::make_unsigned_t<Tp>;
+            const u64 limit = u64(std::numeric_limits<Tp>::max()) + (negative && std::is_signed_v<Tp>);
+            if (magnitude > limit)
+                return std::errc::result_out_of_range;
+            value = negative ? static_cast<Tp>(unsigned_type(0) - static_cast<unsigned_type>(magnitude)) : static_cast<Tp>(magnitude);
+            return std::errc();
+        }
+
+        // readable is the number of bytes that may be loaded starting at p, at least n
+        inline bool parse_digits(const char* p, u64 n, u64 readable, u64& value) noexcept
+        {
+#ifdef UF_SIMD_X86
+            if (n > 1 && readable >= 16 && simd::active() >= simd::level::avx2)
+                return parse_digits_avx2(p, n, value);
+#endif
+            return parse_digits_scalar(p, n, value);
+        }
+
+        template<typename Tp>
+        std::errc parse_fixed(std::string_view field, u64 readable, Tp& value) noexcept
+        {
+            static_assert (std::is_integral_v<Tp> && !std::is_same_v<Tp, bool>, "parse_fixed converts integers only");
+            const bool negative = !field.empty() && field.front() == '-';
+            if (!field.empty() && (negative || field.front() == '+'))
+            {
+                field.remove_prefix(1);
+                --readable;
+            }
+            if (field.empty() || (negative && std::is_unsigned_v<Tp>))
+                return std::errc::invalid_argument;
+            u64 magnitude;
+            if (field.size() <= fixed_digits_max)
+            {
+                if (!parse_digits(field.data(), field.size(), readable, magnitude))
+                    return std::errc::invalid_argument;
+            }
+            else
+            {
+                if (!std::all_of(field.begin(), field.end(), [](char c) { return c >= '0' && c <= '9'; }))
+                    return std::errc::invalid_argument;
+                field.remove_prefix(std::min(field.find_first_not_of('0'), field.size() - 1));
+                if (std::from_chars(field.data(), field.data() + field.size(), magnitude).ec != std::errc())
+                    return std::errc::result_out_of_range;
+            }
+            return signed_magnitude(magnitude, negative, value);
+        }
+    }
+    // namespace detail
+
+    inline namespace convert
+    {
+        // Whole-token conversion: no leading whitespace or '+', trailing characters are an error. Never throws, the
+        // value is left untouched on failure
+        template<typename Tp>
+        std::errc parse(std::string_view s, Tp& value) noexcept
+        {
+            static_assert (std::is_arithmetic_v<Tp> && !std::is_same_v<Tp, bool>, "parse converts numbers only");
+            const char* last = s.data() + s.size();
+            // from_chars writes a valid prefix before the trailing characters are checked
+            Tp result{};
+            std::from_chars_result r;
+            if constexpr (std::is_integral_v<Tp>)
+                r = std::from_chars(s.data(), last, result);
+            else
+                r = std::from_chars(s.data(), last, result, std::chars_format::general);
+            if (r.ec != std::errc())
+                return r.ec;
+            if (r.ptr != last)
+                return std::errc::invalid_argument;
+            value = result;
+            return std::errc();
+        }
+
+        template<typename Tp>
+        std::optional<Tp> parse(std::string_view s) noexcept
+        {
+            Tp result;
+            if (parse(s, result) != std::errc())
+                return std::nullopt;
+            return result;
+        }
+
+        // Writes the shortest text that parses back to value, returns the number of chars written or 0 if out is
+        // too small
+        template<typename Tp>
+        u64 format_to(span<char> out, Tp value) noexcept
+        {
+            static_assert (std::is_arithmetic_v<Tp> && !std::is_same_v<Tp, bool>, "format_to converts numbers only");
+            const auto r = std::to_chars(out.data(), out.data() + out.size(), value);
+            return r.ec == std::errc() ? r.ptr - out.data() : 0;
+        }
+
+        // Parses every token of a column into out (appending), stops at the first bad token and returns how many
+        // tokens were converted
+        template<typename Tp, class Tokens>
+        u64 parse_into(const Tokens& tokens, std::vector<Tp>& out)
+        {
+            if constexpr (mt::is_instantiated_from_v<std::vector, Tokens> || mt::is_span_v<Tokens>)
+                out.reserve(out.size() + std::size(tokens));
+            u64 done = 0;
+            for (const auto& token : tokens)
+            {
+                Tp value;
+                if (parse(detail::token_chars(token), value) != std::errc())
+                    break;
+                out.push_back(value);
+                ++done;
+            }
+            return done;
+        }
+
+        template<typename Tp, class Tokens>
+        std::optional<std::vector<Tp>> parse_all(const Tokens& tokens)
+        {
+            std::vector<Tp> result;
+            const u64 done = parse_into(tokens, result);
+            if (done != static_cast<u64>(std::distance(std::begin(tokens), std::end(tokens))))
+                return std::nullopt;
+            return result;
+        }
+
+        // Integer field of exactly field.size() decimal digits with an optional leading sign, as found in fixed-width
+        // records. Leading zeros are allowed and fields up to 16 digits take the vector path.
+        template<typename Tp>
+        std::errc parse_fixed(std::string_view field, Tp& value) noexcept
+        {
+            return detail::parse_fixed(field, field.size(), value);
+        }
+
+        // Width known at compile time, as in fixed-width record layouts, so the digit loop runs a constant count
+        template<typename Tp, u64 N>
+        std::errc parse_fixed(span<const char, N> field, Tp& value) noexcept
+        {
+            return detail::parse_fixed(std::string_view(field.data(), N), N, value);
+        }
+
+        template<typename Tp>
+        std::optional<Tp> parse_fixed(std::string_view field) noexcept
+        {
+            Tp result;
+            if (parse_fixed(field, result) != std::errc())
+                return std::nullopt;
+            return result;
+        }
+
+        // Consecutive records of stride bytes with a width byte field at the start of each, e.g. one column of a
+        // fixed-width file. Appends to out, stops at the first bad field and returns how many were converted.
+        template<typename Tp>
+        u64 parse_fixed_into(span<const char> data, u64 width, u64 stride, std::vector<Tp>& out)
+        {
+            if (!stride || width > stride)
+                return 0;
+            const u64 records = data.size() / stride + (data.size() % stride >= width);
+            out.reserve(out.size() + records);
+            for (u64 i = 0; i < records; ++i)
+            {
+                Tp value;
+                const char* field = data.data() + i * stride;
+                if (detail::parse_fixed(std::string_view(field, width), data.end() - field, value) != std::errc())
+                    return i;
+                out.push_back(value);
+            }
+            return records;
+        }
+
+        template<typename Tp>
+        u64 parse_fixed_into(span<const char> data, u64 width, std::vector<Tp>& out)
+        {
+            return parse_fixed_into(data, width, width, out);
+        }
+    }
+    // inline namespace convert
+}
+// namespace uf
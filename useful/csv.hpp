@@ -0,0 +1,269 @@
+#pragma once
+#include "simd.hpp"
+#include "arena.hpp"
+#include "file.hpp"
+
+namespace uf
+{
+    namespace detail
+    {
+        // Bit i is the parity of the set bits at positions up to and including i
+        inline u64 prefix_xor(u64 x) noexcept
+        {
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+        }
+    }
+    // namespace detail
+
+    inline namespace csv
+    {
+        struct csv_dialect
+        {
+            char delimiter = ',';
+            char quote = '"';
+        };
+
+        inline constexpr csv_dialect tsv_dialect{'\t', '"'};
+
+        // Streams rows of a delimited file. Quote, delimiter and newline positions are found a block of 64 bytes at
+        // a time as bitmasks, the prefix xor of the quote mask tells which delimiters and newlines are inside quoted
+        // fields. Fields are views into the input, only fields with escaped quotes are unescaped into an arena.
+        // A row and its fields stay valid until the next call to next().
+        class csv_reader
+        {
+        public:
+            using row = span<const std::string_view>;
+
+        private:
+            static constexpr u64 npos = std::numeric_limits<u64>::max();
+
+            input_source m_source;
+            csv_dialect m_dialect;
+            simd::byte_set m_quote;
+            simd::byte_set m_structural;
+
+            std::vector<std::string_view> m_fields;
+            monotonic_arena m_arena;
+            u64 m_row_start = 0;
+
+            // Scanner state over the current window: structural offsets of one batch relative to its start
+            u64 m_quote_masks[simd::detail::batch_blocks];
+            u64 m_structural_masks[simd::detail::batch_blocks];
+            u32 m_positions[simd::detail::batch_blocks * simd::detail::block_size + 8];
+            u64 m_batch_at = 0;
+            u64 m_batch_size = 0;
+            u32 m_count = 0;
+            u32 m_next = 0;
+            u64 m_inside = 0;
+
+            void rewind() noexcept
+            {
+                m_batch_at = 0;
+                m_batch_size = 0;
+                m_count = 0;
+                m_next = 0;
+                m_inside = 0;
+                m_row_start = 0;
+            }
+
+            // Masks a batch of blocks and flattens the structural bits outside of quotes into offsets. Eight offsets
+            // are written per block whether they exist or not, so the loop branches once per block instead of once
+            // per bit.
+            void scan_batch(const char* p, u64 bytes) noexcept
+            {
+                using simd::detail::block_size;
+                const u64 full = bytes / block_size;
+                simd::detail::block_masks(p, full, m_quote, m_quote_masks);
+                simd::detail::block_masks(p, full, m_structural, m_structural_masks);
+                u64 blocks = full;
+                if (const u64 rest = bytes % block_size)
+                {
+                    m_quote_masks[blocks] = simd::detail::block_mask_scalar(p + full * block_size, rest, m_quote);
+                    m_structural_masks[blocks++] = simd::detail::block_mask_scalar(p + full * block_size, rest, m_structural);
+                }
+                u32 n = 0;
+                for (u64 b = 0; b < blocks; ++b)
+                {
+                    const u64 inside = detail::prefix_xor(m_quote_masks[b]) ^ m_inside;
+                    m_inside = 0 - (inside >> 63);
+                    u64 bits = m_structural_masks[b] & ~inside;
+                    const u32 count = __builtin_popcountll(bits);
+                    const u32 base = static_cast<u32>(b * block_size);
+                    u32* out = m_positions + n;
+                    for (u32 k = 0; k < 8; ++k, bits &= bits - 1)
+                        out[k] = base + (bits ? __builtin_ctzll(bits) : 0);
+                    for (u32 k = 8; k < count; ++k, bits &= bits - 1)
+                        out[k] = base + __builtin_ctzll(bits);
+                    n += count;
+                }
+                m_count = n;
+                m_next = 0;
+            }
+
+            // Offset of the next delimiter or newline outside of quotes, npos at the end of the window
+            u64 next_structural(std::string_view window) noexcept
+            {
+                while (m_next == m_count)
+                {
+                    const u64 at = m_batch_at + m_batch_size;
+                    if (at >= window.size())
+                        return npos;
+                    m_batch_at = at;
+                    m_batch_size = std::min<u64>(window.size() - at, simd::detail::batch_blocks * simd::detail::block_size);
+                    scan_batch(window.data() + at, m_batch_size);
+                }
+                return m_batch_at + m_positions[m_next++];
+            }
+
+            void push_field(std::string_view raw, bool last)
+            {
+                if (last && !raw.empty() && raw.back() == '\r')
+                    raw.remove_suffix(1);
+                const char quote = m_dialect.quote;
+                if (raw.empty() || raw.front() != quote)
+                {
+                    m_fields.push_back(raw);
+                    return;
+                }
+                raw.remove_prefix(1);
+                if (!raw.empty() && raw.back() == quote)
+                    raw.remove_suffix(1);
+                if (raw.find(quote) == std::string_view::npos)
+                {
+                    m_fields.push_back(raw);
+                    return;
+                }
+                // Doubled quotes stand for one
+                char* out = m_arena.allocate_array<char>(raw.size()).data();
+                u64 n = 0;
+                for (u64 i = 0; i < raw.size(); ++i)
+                {
+                    out[n++] = raw[i];
+                    if (raw[i] == quote && i + 1 < raw.size() && raw[i + 1] == quote)
+                        ++i;
+                }
+                m_fields.push_back(std::string_view(out, n));
+            }
+
+        public:
+            explicit csv_reader(input_source source, csv_dialect dialect = {}) :
+                m_source(std::move(source)),
+                m_dialect(dialect),
+                m_quote(dialect.quote),
+                m_structural(dialect.delimiter, '\n')
+            {
+            }
+
+            // "-" reads stdin
+            explicit csv_reader(const std::string& path, csv_dialect dialect = {}) : csv_reader(input_source(path), dialect) { }
+
+            // Reads the next row into r, returns false at the end of the input. A line without delimiters is a row
+            // of one field, the final newline does not start an empty row.
+            bool next(row& r)
+            {
+                m_fields.clear();
+                m_arena.reset();
+                u64 field_start = m_row_start;
+                for (;;)
+                {
+                    const std::string_view window = m_source.window();
+                    const u64 p = next_structural(window);
+                    if (p == npos)
+                    {
+                        if (!m_source.exhausted())
+                        {
+                            // The row continues past the window, read more and scan it again from its start
+                            m_source.consume(m_row_start);
+                            m_source.refill();
+                            rewind();
+                            m_fields.clear();
+                            m_arena.reset();
+                            field_start = 0;
+                            continue;
+                        }
+                        if (field_start == window.size() && m_fields.empty())
+                            return false;
+                        push_field(std::string_view(window.data() + field_start, window.size() - field_start), true);
+                        m_row_start = window.size();
+                        break;
+                    }
+                    const bool last = window[p] == '\n';
+                    push_field(std::string_view(window.data() + field_start, p - field_start), last);
+                    field_start = p + 1;
+                    if (last)
+                    {
+                        m_row_start = field_start;
+                        break;
+                    }
+                }
+                r = row(m_fields.data(), m_fields.size());
+                return true;
+            }
+
+            class iterator
+            {
+                csv_reader* m_reader = nullptr;
+                row m_row;
+
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = row;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const row*;
+                using reference = const row&;
+
+                iterator() noexcept = default;
+
+                explicit iterator(csv_reader& reader) : m_reader(&reader)
+                {
+                    ++*this;
+                }
+
+                const row& operator*() const noexcept
+                {
+                    return m_row;
+                }
+
+                const row* operator->() const noexcept
+                {
+                    return &m_row;
+                }
+
+                iterator& operator++()
+                {
+                    if (!m_reader->next(m_row))
+                        m_reader = nullptr;
+                    return *this;
+                }
+
+                bool operator==(const iterator& other) const noexcept
+                {
+                    return m_reader == other.m_reader;
+                }
+
+                bool operator!=(const iterator& other) const noexcept
+                {
+                    return !(*this == other);
+                }
+            };
+
+            iterator begin()
+            {
+                return iterator(*this);
+            }
+
+            iterator end() noexcept
+            {
+                return iterator();
+            }
+        };
+    }
+    // inline namespace csv
+}
+// namespace uf
@@ -0,0 +1,511 @@
+#pragma once
+#include <optional>
+
+#include "span.hpp"
+#include "simd.hpp"
+
+namespace uf
+{
+    namespace detail
+    {
+        inline constexpr char hex_digits[] = "0123456789abcdef";
+
+        inline constexpr char base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        inline constexpr i8 invalid_digit = -1;
+
+        // Value of every char, invalid_digit for chars outside the alphabet
+        template<u64 N>
+        constexpr std::array<i8, 256> digit_values(const char(&alphabet)[N], bool fold_case) noexcept
+        {
+            std::array<i8, 256> result{};
+            for (auto& v : result)
+                v = invalid_digit;
+            for (u64 i = 0; i + 1 < N; ++i)
+            {
+                result[static_cast<u8>(alphabet[i])] = static_cast<i8>(i);
+                if (fold_case && alphabet[i] >= 'a' && alphabet[i] <= 'z')
+                    result[static_cast<u8>(alphabet[i] - 'a' + 'A')] = static_cast<i8>(i);
+            }
+            return result;
+        }
+
+        inline constexpr std::array<i8, 256> hex_values = digit_values(hex_digits, true);
+
+        inline constexpr std::array<i8, 256> base64_values = digit_values(base64_alphabet, false);
+
+        // The SSSE3 kernels run at the sse2 level when the CPU has SSSE3, the AVX2 ones at avx2 and above
+        enum class encoding_kernel : u8
+        {
+            scalar,
+            ssse3,
+            avx2
+        };
+
+        inline encoding_kernel active_encoding_kernel() noexcept
+        {
+#ifdef UF_SIMD_X86
+            switch (simd::active())
+            {
+            case simd::level::avx512:
+            case simd::level::avx2:
+                return encoding_kernel::avx2;
+            case simd::level::sse2:
+            {
+                static const bool ssse3 = __builtin_cpu_supports("ssse3");
+                return ssse3 ? encoding_kernel::ssse3 : encoding_kernel::scalar;
+            }
+            case simd::level::scalar:
+                break;
+            }
+#endif
+            return encoding_kernel::scalar;
+        }
+
+        inline void hex_encode_scalar(const u8* in, u64 n, char* out) noexcept
+        {
+            for (u64 i = 0; i < n; ++i)
+            {
+                out[2 * i] = hex_digits[in[i] >> 4];
+                out[2 * i + 1] = hex_digits[in[i] & 15];
+            }
+        }
+
+        inline bool hex_decode_scalar(const char* in, u64 n, u8* out) noexcept
+        {
+            for (u64 i = 0; i < n; ++i)
+            {
+                const i8 high = hex_values[static_cast<u8>(in[2 * i])];
+                const i8 low = hex_values[static_cast<u8>(in[2 * i + 1])];
+                if ((high | low) < 0)
+                    return false;
+                out[i] = static_cast<u8>(high << 4 | low);
+            }
+            return true;
+        }
+
+        // Encodes whole groups of 3 bytes into 4 chars
+        inline void base64_encode_scalar(const u8* in, u64 groups, char* out) noexcept
+        {
+            for (u64 g = 0; g < groups; ++g, in += 3, out += 4)
+            {
+                const u32 v = u32(in[0]) << 16 | u32(in[1]) << 8 | in[2];
+                out[0] = base64_alphabet[v >> 18];
+                out[1] = base64_alphabet[v >> 12 & 63];
+                out[2] = base64_alphabet[v >> 6 & 63];
+                out[3] = base64_alphabet[v & 63];
+            }
+        }
+
+        // Decodes whole groups of 4 chars without padding into 3 bytes
+        inline bool base64_decode_scalar(const char* in, u64 groups, u8* out) noexcept
+        {
+            for (u64 g = 0; g < groups; ++g, in += 4, out += 3)
+            {
+                const i32 a = base64_values[static_cast<u8>(in[0])], b = base64_values[static_cast<u8>(in[1])];
+                const i32 c = base64_values[static_cast<u8>(in[2])], d = base64_values[static_cast<u8>(in[3])];
+                if ((a | b | c | d) < 0)
+                    return false;
+                const u32 v = u32(a) << 18 | u32(b) << 12 | u32(c) << 6 | u32(d);
+                out[0] = static_cast<u8>(v >> 16);
+                out[1] = static_cast<u8>(v >> 8);
+                out[2] = static_cast<u8>(v);
+            }
+            return true;
+        }
+
+        // The vector kernels below handle whole blocks and return how many input bytes (encode) or chars (decode)
+        // they consumed, the scalar code finishes the rest. Decoders return npos on an invalid char.
+#ifdef UF_SIMD_X86
+        // Nibbles are looked up in the digit table and interleaved high first
+        UF_TARGET("ssse3") inline u64 hex_encode_ssse3(const u8* in, u64 n, char* out) noexcept
+        {
+            const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex_digits));
+            const __m128i nibble = _mm_set1_epi8(0x0f);
+            u64 i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                const __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+                const __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(v, nibble));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(high, low));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+            }
+            return i;
+        }
+
+        UF_TARGET("avx2") inline u64 hex_encode_avx2(const u8* in, u64 n, char* out) noexcept
+        {
+            const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex_digits)));
+            const __m256i nibble = _mm256_set1_epi8(0x0f);
+            u64 i = 0;
+            for (; i + 32 <= n; i += 32)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                const __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+                const __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, nibble));
+                // Unpacking works per 128-bit lane, the halves are put back in order afterwards
+                const __m256i first = _mm256_unpacklo_epi8(high, low);
+                const __m256i second = _mm256_unpackhi_epi8(high, low);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+            }
+            return i;
+        }
+
+        // Digits are c - '0' below 10, letters (c | 0x20) - 'a' below 6, anything else fails the block. Pairs of
+        // nibbles are then joined with one multiply-add.
+        UF_TARGET("ssse3") inline __m128i hex_values_ssse3(__m128i c, __m128i& bad) noexcept
+        {
+            const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+            const __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+            const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+            bad = _mm_or_si128(bad, _mm_andnot_si128(_mm_or_si128(is_digit, is_letter), _mm_set1_epi8(-1)));
+            const __m128i value = _mm_or_si128(_mm_and_si128(is_digit, digit), _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+            return _mm_maddubs_epi16(value, _mm_set1_epi16(0x0110));
+        }
+
+        UF_TARGET("ssse3") inline u64 hex_decode_ssse3(const char* in, u64 n, u8* out) noexcept
+        {
+            u64 i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                __m128i bad = _mm_setzero_si128();
+                const __m128i a = hex_values_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i)), bad);
+                const __m128i b = hex_values_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i + 16)), bad);
+                if (_mm_movemask_epi8(bad))
+                    return std::numeric_limits<u64>::max();
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(a, b));
+            }
+            return i;
+        }
+
+        UF_TARGET("avx2") inline __m256i hex_values_avx2(__m256i c, __m256i& bad) noexcept
+        {
+            const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+            const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+            const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+            const __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+            bad = _mm256_or_si256(bad, _mm256_andnot_si256(_mm256_or_si256(is_digit, is_letter), _mm256_set1_epi8(-1)));
+            const __m256i value = _mm256_or_si256(_mm256_and_si256(is_digit, digit), _mm256_and_si256(is_letter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+            return _mm256_maddubs_epi16(value, _mm256_set1_epi16(0x0110));
+        }
+
+        UF_TARGET("avx2") inline u64 hex_decode_avx2(const char* in, u64 n, u8* out) noexcept
+        {
+            u64 i = 0;
+            for (; i + 32 <= n; i += 32)
+            {
+                __m256i bad = _mm256_setzero_si256();
+                const __m256i a = hex_values_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i)), bad);
+                const __m256i b = hex_values_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i + 32)), bad);
+                if (_mm256_movemask_epi8(bad))
+                    return std::numeric_limits<u64>::max();
+                // Packing interleaves the lanes of a and b, the permute restores byte order
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8));
+            }
+            return i;
+        }
+
+        // Base64 kernels after Wojciech Mula and Daniel Lemire: 3 byte groups are spread over 32-bit slots, the four
+        // 6-bit indices are cut out with multiplies, and a small table turns index ranges into ASCII offsets.
+        UF_TARGET("ssse3") inline __m128i base64_chars_ssse3(__m128i v) noexcept
+        {
+            v = _mm_shuffle_epi8(v, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+            const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+            const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+            const __m128i indices = _mm_or_si128(t0, t1);
+            __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+            range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+            const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                  '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+            return _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+        }
+
+        UF_TARGET("ssse3") inline u64 base64_encode_ssse3(const u8* in, u64 n, char* out) noexcept
+        {
+            // Every step reads 16 bytes and uses 12 of them
+            u64 i = 0;
+            for (; i + 16 <= n; i += 12, out += 16)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), base64_chars_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+            return i;
+        }
+
+        UF_TARGET("avx2") inline u64 base64_encode_avx2(const u8* in, u64 n, char* out) noexcept
+        {
+            const __m256i spread = _mm256_broadcastsi128_si256(_mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+            const __m256i offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                                              '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+            u64 i = 0;
+            for (; i + 28 <= n; i += 24, out += 32)
+            {
+                // Each lane gets the 12 bytes of its 16 output chars
+                const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12));
+                const __m256i v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), spread);
+                const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+                const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+                const __m256i indices = _mm256_or_si256(t0, t1);
+                __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+                range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices));
+            }
+            return i;
+        }
+
+        // Chars are classified by their nibbles: a char is valid when the bit sets looked up by its low and high
+        // nibble do not intersect. The high nibble (and '/' separately) then selects the offset back to 0..63.
+        UF_TARGET("ssse3") inline __m128i base64_values_ssse3(__m128i c, __m128i& bad) noexcept
+        {
+            const __m128i high_nibble = _mm_and_si128(_mm_srli_epi32(c, 4), _mm_set1_epi8(0x0f));
+            const __m128i low_nibble = _mm_and_si128(c, _mm_set1_epi8(0x0f));
+            const __m128i low_sets = _mm_shuffle_epi8(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a), low_nibble);
+            const __m128i high_sets = _mm_shuffle_epi8(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10), high_nibble);
+            bad = _mm_or_si128(bad, _mm_and_si128(low_sets, high_sets));
+            const __m128i slash = _mm_cmpeq_epi8(c, _mm_set1_epi8('/'));
+            const __m128i roll = _mm_shuffle_epi8(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0), _mm_add_epi8(slash, high_nibble));
+            const __m128i values = _mm_add_epi8(c, roll);
+            // Join four 6-bit values into 24 bits per 32-bit slot
+            const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+            return _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        }
+
+        UF_TARGET("ssse3") inline u64 base64_decode_ssse3(const char* in, u64 n, u8* out, u64 writable) noexcept
+        {
+            const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+            u64 i = 0, o = 0;
+            // Every step writes 16 bytes of which 12 are output
+            for (; i + 16 <= n && o + 16 <= writable; i += 16, o += 12)
+            {
+                __m128i bad = _mm_setzero_si128();
+                const __m128i words = base64_values_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), bad);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(bad, _mm_setzero_si128())) != 0xffff)
+                    return std::numeric_limits<u64>::max();
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm_shuffle_epi8(words, pack));
+            }
+            return i;
+        }
+
+        UF_TARGET("avx2") inline u64 base64_decode_avx2(const char* in, u64 n, u8* out, u64 writable) noexcept
+        {
+            const __m256i low_table = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a));
+            const __m256i high_table = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+            const __m256i roll_table = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+            const __m256i pack = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+            u64 i = 0, o = 0;
+            for (; i + 32 <= n && o + 32 <= writable; i += 32, o += 24)
+            {
+                const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                const __m256i high_nibble = _mm256_and_si256(_mm256_srli_epi32(c, 4), _mm256_set1_epi8(0x0f));
+                const __m256i low_nibble = _mm256_and_si256(c, _mm256_set1_epi8(0x0f));
+                const __m256i bad = _mm256_and_si256(_mm256_shuffle_epi8(low_table, low_nibble), _mm256_shuffle_epi8(high_table, high_nibble));
+                if (!_mm256_testz_si256(bad, bad))
+                    return std::numeric_limits<u64>::max();
+                const __m256i slash = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('/'));
+                const __m256i values = _mm256_add_epi8(c, _mm256_shuffle_epi8(roll_table, _mm256_add_epi8(slash, high_nibble)));
+                const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+                const __m256i words = _mm256_shuffle_epi8(_mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000)), pack);
+                // 12 bytes per lane, the permute closes the gap between the lanes
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + o), _mm256_permutevar8x32_epi32(words, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+            }
+            return i;
+        }
+#endif
+    }
+    // namespace detail
+
+    inline namespace encoding
+    {
+        inline constexpr u64 hex_encoded_size(u64 bytes) noexcept
+        {
+            return bytes * 2;
+        }
+
+        // Bytes decoded from a valid hex text of this many chars
+        inline constexpr u64 hex_decoded_size(u64 chars) noexcept
+        {
+            return chars / 2;
+        }
+
+        // Padded output, every started group of 3 bytes takes 4 chars
+        inline constexpr u64 base64_encoded_size(u64 bytes) noexcept
+        {
+            return (bytes + 2) / 3 * 4;
+        }
+
+        // Exact number of bytes decoded from a valid base64 text, the padding is taken into account
+        inline u64 base64_decoded_size(span<const char> text) noexcept
+        {
+            const u64 n = text.size();
+            if (n % 4)
+                return n / 4 * 3;
+            const u64 padding = n && text[n - 1] == '=' ? (text[n - 2] == '=' ? 2 : 1) : 0;
+            return n / 4 * 3 - padding;
+        }
+
+        // Lowercase hex digits of in, returns the number of chars written or 0 if out is too small
+        inline u64 hex_encode(span<const std::byte> in, span<char> out) noexcept
+        {
+            const u64 n = in.size();
+            if (out.size() < hex_encoded_size(n))
+                return 0;
+            const u8* src = reinterpret_cast<const u8*>(in.data());
+            u64 done = 0;
+#ifdef UF_SIMD_X86
+            switch (detail::active_encoding_kernel())
+            {
+            case detail::encoding_kernel::avx2:
+                done = detail::hex_encode_avx2(src, n, out.data());
+                break;
+            case detail::encoding_kernel::ssse3:
+                done = detail::hex_encode_ssse3(src, n, out.data());
+                break;
+            case detail::encoding_kernel::scalar:
+                break;
+            }
+#endif
+            detail::hex_encode_scalar(src + done, n - done, out.data() + 2 * done);
+            return hex_encoded_size(n);
+        }
+
+        inline std::string hex_encode(span<const std::byte> in)
+        {
+            std::string result(hex_encoded_size(in.size()), '\0');
+            hex_encode(in, span<char>(result));
+            return result;
+        }
+
+        // Accepts digits of either case and nothing else, the length must be even. Returns the number of bytes
+        // written, or nullopt for invalid text or an out smaller than hex_decoded_size.
+        inline std::optional<u64> hex_decode(span<const char> in, span<std::byte> out) noexcept
+        {
+            const u64 n = hex_decoded_size(in.size());
+            if (in.size() % 2 || out.size() < n)
+                return std::nullopt;
+            u8* dst = reinterpret_cast<u8*>(out.data());
+            u64 done = 0;
+#ifdef UF_SIMD_X86
+            switch (detail::active_encoding_kernel())
+            {
+            case detail::encoding_kernel::avx2:
+                done = detail::hex_decode_avx2(in.data(), n, dst);
+                break;
+            case detail::encoding_kernel::ssse3:
+                done = detail::hex_decode_ssse3(in.data(), n, dst);
+                break;
+            case detail::encoding_kernel::scalar:
+                break;
+            }
+            if (done == std::numeric_limits<u64>::max())
+                return std::nullopt;
+#endif
+            if (!detail::hex_decode_scalar(in.data() + 2 * done, n - done, dst + done))
+                return std::nullopt;
+            return n;
+        }
+
+        // Standard alphabet with '=' padding, returns the number of chars written or 0 if out is too small
+        inline u64 base64_encode(span<const std::byte> in, span<char> out) noexcept
+        {
+            const u64 n = in.size();
+            const u64 size = base64_encoded_size(n);
+            if (out.size() < size)
+                return 0;
+            const u8* src = reinterpret_cast<const u8*>(in.data());
+            char* dst = out.data();
+            u64 done = 0;
+#ifdef UF_SIMD_X86
+            switch (detail::active_encoding_kernel())
+            {
+            case detail::encoding_kernel::avx2:
+                done = detail::base64_encode_avx2(src, n, dst);
+                break;
+            case detail::encoding_kernel::ssse3:
+                done = detail::base64_encode_ssse3(src, n, dst);
+                break;
+            case detail::encoding_kernel::scalar:
+                break;
+            }
+#endif
+            const u64 groups = (n - done) / 3;
+            detail::base64_encode_scalar(src + done, groups, dst + done / 3 * 4);
+            done += groups * 3;
+            if (const u64 rest = n - done)
+            {
+                char* last = dst + size - 4;
+                const u32 v = u32(src[done]) << 16 | (rest == 2 ? u32(src[done + 1]) << 8 : 0);
+                last[0] = detail::base64_alphabet[v >> 18];
+                last[1] = detail::base64_alphabet[v >> 12 & 63];
+                last[2] = rest == 2 ? detail::base64_alphabet[v >> 6 & 63] : '=';
+                last[3] = '=';
+            }
+            return size;
+        }
+
+        inline std::string base64_encode(span<const std::byte> in)
+        {
+            std::string result(base64_encoded_size(in.size()), '\0');
+            base64_encode(in, span<char>(result));
+            return result;
+        }
+
+        // Strict: the length must be a multiple of 4, '=' may only pad the last group, the bits dropped by padding
+        // must be zero, and no whitespace or other chars are allowed. Returns the number of bytes written, or nullopt
+        // for invalid text or an out smaller than base64_decoded_size.
+        inline std::optional<u64> base64_decode(span<const char> in, span<std::byte> out) noexcept
+        {
+            const u64 n = in.size();
+            if (n % 4)
+                return std::nullopt;
+            const u64 size = base64_decoded_size(in);
+            if (out.size() < size)
+                return std::nullopt;
+            if (!n)
+                return 0;
+            const char* src = in.data();
+            u8* dst = reinterpret_cast<u8*>(out.data());
+            // The last group may carry padding and always goes through the scalar code. Vector stores run a few bytes
+            // past their output and are limited to size, so a larger out keeps its bytes after the decoded ones.
+            const u64 body = n - 4;
+            u64 done = 0;
+#ifdef UF_SIMD_X86
+            switch (detail::active_encoding_kernel())
+            {
+            case detail::encoding_kernel::avx2:
+                done = detail::base64_decode_avx2(src, body, dst, size);
+                break;
+            case detail::encoding_kernel::ssse3:
+                done = detail::base64_decode_ssse3(src, body, dst, size);
+                break;
+            case detail::encoding_kernel::scalar:
+                break;
+            }
+            if (done == std::numeric_limits<u64>::max())
+                return std::nullopt;
+#endif
+            if (!detail::base64_decode_scalar(src + done, (body - done) / 4, dst + done / 4 * 3))
+                return std::nullopt;
+
+            const char* last = src + body;
+            const u64 padding = 3 - (size - body / 4 * 3);
+            const i32 a = detail::base64_values[static_cast<u8>(last[0])], b = detail::base64_values[static_cast<u8>(last[1])];
+            const i32 c = padding == 2 ? 0 : detail::base64_values[static_cast<u8>(last[2])];
+            const i32 d = padding ? 0 : detail::base64_values[static_cast<u8>(last[3])];
+            if ((a | b | c | d) < 0)
+                return std::nullopt;
+            const u32 v = u32(a) << 18 | u32(b) << 12 | u32(c) << 6 | u32(d);
+            if (padding && (v & (padding == 2 ? 0xffff : 0xff)))
+                return std::nullopt;
+            u8* tail = dst + body / 4 * 3;
+            tail[0] = static_cast<u8>(v >> 16);
+            if (padding < 2)
+                tail[1] = static_cast<u8>(v >> 8);
+            if (!padding)
+                tail[2] = static_cast<u8>(v);
+            return size;
+        }
+    }
+    // inline namespace encoding
+}
+// namespace uf
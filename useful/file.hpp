@@ -0,0 +1,315 @@
+#pragma once
+#include <cerrno>
+#include <cstdlib>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "span.hpp"
+
+namespace uf
+{
+    inline namespace file
+    {
+        // Sliding window over the contents of a file. Regular files are memory-mapped whole, so the window is the
+        // entire file from the start. Pipes, terminals and stdin are read in large page-aligned blocks, so the window
+        // holds whatever has been read but not yet consumed. Text given directly is borrowed as is.
+        class input_source
+        {
+        public:
+            static constexpr u64 default_block_size = 1 << 20;
+
+        private:
+            static constexpr u64 page_size = 4096;
+
+            struct buffer_deleter
+            {
+                void operator()(char* p) const noexcept
+                {
+                    std::free(p);
+                }
+            };
+
+            int m_fd = -1;
+            bool m_owns_fd = false;
+            void* m_mapping = nullptr;
+            u64 m_mapping_size = 0;
+            std::unique_ptr<char, buffer_deleter> m_buffer;
+            u64 m_capacity = 0;
+            u64 m_block_size = default_block_size;
+            const char* m_begin = nullptr;
+            const char* m_end = nullptr;
+            bool m_exhausted = true;
+
+            [[noreturn]] static void fail(const char* what)
+            {
+                throw std::system_error(errno, std::generic_category(), what);
+            }
+
+            void open_fd()
+            {
+                struct stat info;
+                if (fstat(m_fd, &info))
+                    fail("input_source: fstat failed");
+                if (S_ISREG(info.st_mode) && info.st_size > 0)
+                {
+                    m_mapping_size = info.st_size;
+                    m_mapping = mmap(nullptr, m_mapping_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+                    if (m_mapping == MAP_FAILED)
+                    {
+                        m_mapping = nullptr;
+                        fail("input_source: mmap failed");
+                    }
+                    madvise(m_mapping, m_mapping_size, MADV_SEQUENTIAL);
+                    m_begin = static_cast<const char*>(m_mapping);
+                    m_end = m_begin + m_mapping_size;
+                    return;
+                }
+                m_exhausted = false;
+                refill();
+            }
+
+            void close() noexcept
+            {
+                if (m_mapping)
+                    munmap(m_mapping, m_mapping_size);
+                if (m_owns_fd)
+                    ::close(m_fd);
+                m_mapping = nullptr;
+                m_owns_fd = false;
+            }
+
+        public:
+            // "-" reads stdin
+            explicit input_source(const std::string& path, u64 block_size = default_block_size) : m_block_size(block_size)
+            {
+                if (path == "-")
+                    m_fd = STDIN_FILENO;
+                else
+                {
+                    m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                    if (m_fd < 0)
+                        fail("input_source: cannot open file");
+                    m_owns_fd = true;
+                }
+                try
+                {
+                    open_fd();
+                }
+                catch (...)
+                {
+                    close();
+                    throw;
+                }
+            }
+
+            // Reads from a descriptor owned by the caller
+            explicit input_source(int fd, u64 block_size = default_block_size) : m_fd(fd), m_block_size(block_size)
+            {
+                open_fd();
+            }
+
+            // Borrows text that outlives the source
+            explicit input_source(std::string_view text) noexcept : m_begin(text.data()), m_end(text.data() + text.size()) { }
+
+            input_source(const input_source&) = delete;
+
+            input_source(input_source&& other) noexcept
+            {
+                *this = std::move(other);
+            }
+
+            input_source& operator=(const input_source&) = delete;
+
+            input_source& operator=(input_source&& other) noexcept
+            {
+                if (this == &other)
+                    return *this;
+                close();
+                m_fd = std::exchange(other.m_fd, -1);
+                m_owns_fd = std::exchange(other.m_owns_fd, false);
+                m_mapping = std::exchange(other.m_mapping, nullptr);
+                m_mapping_size = std::exchange(other.m_mapping_size, 0);
+                m_buffer = std::move(other.m_buffer);
+                m_capacity = std::exchange(other.m_capacity, 0);
+                m_block_size = other.m_block_size;
+                m_begin = std::exchange(other.m_begin, nullptr);
+                m_end = std::exchange(other.m_end, nullptr);
+                m_exhausted = std::exchange(other.m_exhausted, true);
+                return *this;
+            }
+
+            ~input_source()
+            {
+                close();
+            }
+
+            bool mapped() const noexcept
+            {
+                return m_mapping;
+            }
+
+            // Unconsumed bytes that are already available
+            std::string_view window() const noexcept
+            {
+                return std::string_view(m_begin, m_end - m_begin);
+            }
+
+            void consume(u64 n) noexcept
+            {
+                m_begin += n;
+            }
+
+            // True once the window holds everything that is left of the input
+            bool exhausted() const noexcept
+            {
+                return m_exhausted;
+            }
+
+            // Keeps the unconsumed bytes and appends what one read returns, up to a block. The window moves and views
+            // into it are invalidated. Returns false when the input has nothing more.
+            bool refill()
+            {
+                if (m_exhausted)
+                    return false;
+                const u64 kept = m_end - m_begin;
+                const u64 required = (kept + m_block_size + page_size - 1) / page_size * page_size;
+                if (required > m_capacity)
+                {
+                    std::unique_ptr<char, buffer_deleter> grown(static_cast<char*>(std::aligned_alloc(page_size, required)));
+                    if (!grown)
+                        throw std::bad_alloc();
+                    if (kept)
+                        std::memcpy(grown.get(), m_begin, kept);
+                    m_buffer = std::move(grown);
+                    m_capacity = required;
+                }
+                else if (kept)
+                    std::memmove(m_buffer.get(), m_begin, kept);
+                m_begin = m_buffer.get();
+                m_end = m_begin + kept;
+
+                for (;;)
+                {
+                    const ssize_t r = ::read(m_fd, const_cast<char*>(m_end), m_buffer.get() + m_capacity - m_end);
+                    if (r < 0 && errno == EINTR)
+                        continue;
+                    if (r < 0)
+                        fail("input_source: read failed");
+                    m_end += r;
+                    m_exhausted = !r;
+                    break;
+                }
+                return !m_exhausted;
+            }
+        };
+
+        // Lines of a file as views without the newline, a final line without one is still yielded. Newlines are found
+        // with memchr, which glibc vectorizes. Lines of a mapped file stay valid as long as the range, lines read from
+        // a pipe or stdin only until the next line is taken.
+        class mapped_lines
+        {
+            input_source m_source;
+            // Bytes of the window already known to hold no newline
+            u64 m_searched = 0;
+
+        public:
+            explicit mapped_lines(input_source source) noexcept : m_source(std::move(source)) { }
+
+            // "-" reads stdin
+            explicit mapped_lines(const std::string& path, u64 block_size = input_source::default_block_size) : m_source(path, block_size) { }
+
+            // Reads the next line into line, returns false at the end of the input
+            bool next(std::string_view& line)
+            {
+                for (;;)
+                {
+                    const std::string_view window = m_source.window();
+                    const void* found = m_searched < window.size() ? std::memchr(window.data() + m_searched, '\n', window.size() - m_searched) : nullptr;
+                    if (found)
+                    {
+                        const u64 end = static_cast<const char*>(found) - window.data();
+                        line = window.substr(0, end);
+                        m_source.consume(end + 1);
+                        m_searched = 0;
+                        return true;
+                    }
+                    if (m_source.exhausted())
+                    {
+                        if (window.empty())
+                            return false;
+                        line = window;
+                        m_source.consume(window.size());
+                        m_searched = 0;
+                        return true;
+                    }
+                    // The line continues past the window, the unconsumed part is kept by the refill
+                    m_searched = window.size();
+                    m_source.refill();
+                }
+            }
+
+            class iterator
+            {
+                mapped_lines* m_lines = nullptr;
+                std::string_view m_line;
+
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = std::string_view;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const std::string_view*;
+                using reference = const std::string_view&;
+
+                iterator() noexcept = default;
+
+                explicit iterator(mapped_lines& lines) : m_lines(&lines)
+                {
+                    ++*this;
+                }
+
+                const std::string_view& operator*() const noexcept
+                {
+                    return m_line;
+                }
+
+                const std::string_view* operator->() const noexcept
+                {
+                    return &m_line;
+                }
+
+                iterator& operator++()
+                {
+                    if (!m_lines->next(m_line))
+                        m_lines = nullptr;
+                    return *this;
+                }
+
+                bool operator==(const iterator& other) const noexcept
+                {
+                    return m_lines == other.m_lines;
+                }
+
+                bool operator!=(const iterator& other) const noexcept
+                {
+                    return !(*this == other);
+                }
+            };
+
+            iterator begin()
+            {
+                return iterator(*this);
+            }
+
+            iterator end() noexcept
+            {
+                return iterator();
+            }
+        };
+    }
+    // inline namespace file
+}
+// namespace uf
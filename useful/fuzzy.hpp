@@ -0,0 +1,220 @@
+#pragma once
+#include "span.hpp"
+
+namespace uf
+{
+    namespace detail
+    {
+        inline constexpr u64 word_bits = 64;
+
+        // Row r counted from 1, the low r bits of a word
+        inline u64 low_rows(u64 r) noexcept
+        {
+            return r >= word_bits ? ~u64(0) : (u64(1) << r) - 1;
+        }
+
+        // Myers' bit-vector edit distance, pattern rows are the bits of a word and text chars are the columns. pv and
+        // mv hold the vertical +1 and -1 deltas of the current column. Cells on a diagonal never decrease, so once the
+        // cell of the column on the diagonal ending in the last cell is above k the distance is too.
+        template<bool Bounded>
+        u64 myers_word(const u64* peq, u64 m, std::string_view text, u64 k) noexcept
+        {
+            const u64 n = text.size();
+            u64 pv = ~u64(0), mv = 0;
+            for (u64 c = 1; c <= n; ++c)
+            {
+                const u64 eq = peq[static_cast<u8>(text[c - 1])];
+                const u64 xv = eq | mv;
+                const u64 xh = (((eq & pv) + pv) ^ pv) | eq;
+                const u64 ph = (mv | ~(xh | pv)) << 1 | 1;
+                const u64 mh = (pv & xh) << 1;
+                pv = mh | ~(xv | ph);
+                mv = ph & xv;
+                if constexpr (Bounded)
+                {
+                    if (c + m >= n)
+                    {
+                        const u64 mask = low_rows(c + m - n);
+                        if (c + __builtin_popcountll(pv & mask) - __builtin_popcountll(mv & mask) > k)
+                            return k + 1;
+                    }
+                }
+            }
+            const u64 mask = low_rows(m);
+            const u64 result = n + __builtin_popcountll(pv & mask) - __builtin_popcountll(mv & mask);
+            return Bounded && result > k ? k + 1 : result;
+        }
+
+        // Same over several words per column, the horizontal delta leaving the bottom of a block enters the top of the
+        // next one. bottom[b] is the cell in the last row of block b.
+        template<bool Bounded>
+        u64 myers_blocks(const u64* peq, u64 blocks, u64 m, std::string_view text, u64 k)
+        {
+            const u64 n = text.size();
+            std::vector<u64> pv(blocks, ~u64(0)), mv(blocks, 0), bottom(blocks);
+            for (u64 b = 0; b < blocks; ++b)
+                bottom[b] = (b + 1) * word_bits;
+
+            const auto cell = [&](u64 r, u64 c)
+            {
+                if (!r)
+                    return c;
+                const u64 b = (r - 1) / word_bits;
+                const u64 mask = low_rows(r - b * word_bits);
+                return (b ? bottom[b - 1] : c) + __builtin_popcountll(pv[b] & mask) - __builtin_popcountll(mv[b] & mask);
+            };
+
+            for (u64 c = 1; c <= n; ++c)
+            {
+                const u64* eqs = peq + static_cast<u8>(text[c - 1]) * blocks;
+                // Row 0 grows by one in every column
+                int hin = 1;
+                for (u64 b = 0; b < blocks; ++b)
+                {
+                    const u64 in_minus = hin < 0;
+                    const u64 xv = eqs[b] | mv[b];
+                    const u64 eq = eqs[b] | in_minus;
+                    const u64 xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+                    u64 ph = mv[b] | ~(xh | pv[b]);
+                    u64 mh = pv[b] & xh;
+                    const int hout = static_cast<int>(ph >> 63) - static_cast<int>(mh >> 63);
+                    ph = ph << 1 | (hin > 0);
+                    mh = mh << 1 | in_minus;
+                    pv[b] = mh | ~(xv | ph);
+                    mv[b] = ph & xv;
+                    bottom[b] += hout;
+                    hin = hout;
+                }
+                if constexpr (Bounded)
+                {
+                    if (c + m >= n && cell(c + m - n, c) > k)
+                        return k + 1;
+                }
+            }
+            const u64 result = cell(m, n);
+            return Bounded && result > k ? k + 1 : result;
+        }
+
+        // Per byte, the bits of the query positions where it occurs, blocks words per byte
+        inline void build_peq(std::string_view query, u64 blocks, u64* peq) noexcept
+        {
+            for (u64 i = 0; i < query.size(); ++i)
+                peq[static_cast<u8>(query[i]) * blocks + i / word_bits] |= u64(1) << (i % word_bits);
+        }
+
+        template<bool Bounded>
+        u64 levenshtein(std::string_view a, std::string_view b, u64 k)
+        {
+            const u64 prefix = std::mismatch(a.begin(), a.begin() + std::min(a.size(), b.size()), b.begin()).first - a.begin();
+            a.remove_prefix(prefix);
+            b.remove_prefix(prefix);
+            const u64 suffix = std::mismatch(a.rbegin(), a.rbegin() + std::min(a.size(), b.size()), b.rbegin()).first - a.rbegin();
+            a.remove_suffix(suffix);
+            b.remove_suffix(suffix);
+            if (a.size() > b.size())
+                std::swap(a, b);
+            if (Bounded && b.size() - a.size() > k)
+                return k + 1;
+            if (a.empty())
+                return b.size();
+            if (a.size() <= word_bits)
+            {
+                std::array<u64, 256> peq{};
+                build_peq(a, 1, peq.data());
+                return myers_word<Bounded>(peq.data(), a.size(), b, k);
+            }
+            const u64 blocks = (a.size() + word_bits - 1) / word_bits;
+            std::vector<u64> peq(256 * blocks, 0);
+            build_peq(a, blocks, peq.data());
+            return myers_blocks<Bounded>(peq.data(), blocks, a.size(), b, k);
+        }
+    }
+    // namespace detail
+
+    inline namespace fuzzy
+    {
+        // Query compiled once for many edit distance computations: per byte, the bits of the query positions where
+        // it occurs. Queries up to 64 bytes take one word per text byte and never allocate.
+        class levenshtein_pattern
+        {
+            u64 m_size = 0;
+            u64 m_blocks = 0;
+            std::vector<u64> m_peq;
+
+        public:
+            explicit levenshtein_pattern(std::string_view query) :
+                m_size(query.size()),
+                m_blocks((query.size() + detail::word_bits - 1) / detail::word_bits),
+                m_peq(256 * std::max<u64>(m_blocks, 1), 0)
+            {
+                detail::build_peq(query, m_blocks, m_peq.data());
+            }
+
+            u64 size() const noexcept
+            {
+                return m_size;
+            }
+
+            // Levenshtein distance between the query and text, bytes are compared as is
+            u64 distance(std::string_view text) const
+            {
+                if (!m_size)
+                    return text.size();
+                if (m_blocks == 1)
+                    return detail::myers_word<false>(m_peq.data(), m_size, text, 0);
+                return detail::myers_blocks<false>(m_peq.data(), m_blocks, m_size, text, 0);
+            }
+
+            // The distance if it is at most k, otherwise k + 1, found without finishing the columns once it is certain
+            u64 bounded_distance(std::string_view text, u64 k) const
+            {
+                const u64 difference = m_size > text.size() ? m_size - text.size() : text.size() - m_size;
+                if (difference > k)
+                    return k + 1;
+                if (!m_size)
+                    return text.size();
+                if (m_blocks == 1)
+                    return detail::myers_word<true>(m_peq.data(), m_size, text, k);
+                return detail::myers_blocks<true>(m_peq.data(), m_blocks, m_size, text, k);
+            }
+        };
+
+        // Edit distance with unit cost insertions, deletions and substitutions of bytes. The common prefix and suffix
+        // are skipped and the shorter string becomes the bit-vector pattern.
+        inline u64 levenshtein(std::string_view a, std::string_view b)
+        {
+            return detail::levenshtein<false>(a, b, 0);
+        }
+
+        // The distance if it is at most k, otherwise k + 1. Strings whose lengths differ by more than k are rejected
+        // up front, others as soon as the distance is certain to exceed k.
+        inline u64 bounded_levenshtein(std::string_view a, std::string_view b, u64 k)
+        {
+            return detail::levenshtein<true>(a, b, k);
+        }
+
+        // Distances from one query to every candidate, the query is compiled once
+        template<class Candidates>
+        std::vector<u64> levenshtein_batch(std::string_view query, const Candidates& candidates)
+        {
+            const levenshtein_pattern pattern(query);
+            std::vector<u64> result;
+            for (const auto& candidate : candidates)
+                result.push_back(pattern.distance(candidate));
+            return result;
+        }
+
+        // Same with bounded_levenshtein semantics, candidates further than k from the query get k + 1
+        template<class Candidates>
+        std::vector<u64> bounded_levenshtein_batch(std::string_view query, const Candidates& candidates, u64 k)
+        {
+            const levenshtein_pattern pattern(query);
+            std::vector<u64> result;
+            for (const auto& candidate : candidates)
+                result.push_back(pattern.bounded_distance(candidate, k));
+            return result;
+        }
+    }
+    // inline namespace fuzzy
+}
+// namespace uf
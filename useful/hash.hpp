@@ -0,0 +1,228 @@
+#pragma once
+#include <optional>
+
+#include "span.hpp"
+
+namespace uf
+{
+    namespace detail
+    {
+        __extension__ typedef unsigned __int128 hash_u128;
+
+        inline constexpr u64 hash_secret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+        // Folds the full 128-bit product of a and b into 64 bits
+        inline u64 hash_mix(u64 a, u64 b) noexcept
+        {
+            const hash_u128 r = static_cast<hash_u128>(a) * b;
+            return static_cast<u64>(r) ^ static_cast<u64>(r >> 64);
+        }
+
+        inline u64 hash_read8(const u8* p) noexcept
+        {
+            u64 v;
+            std::memcpy(&v, p, 8);
+            return v;
+        }
+
+        inline u64 hash_read4(const u8* p) noexcept
+        {
+            u32 v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+
+        // Inputs over 16 bytes, 48 bytes at a time in three independent lanes, leaves the last two words in a and b
+        inline u64 hash_long(const u8* p, u64 n, u64 seed, u64& a, u64& b) noexcept
+        {
+            const u64* s = hash_secret;
+            u64 i = n;
+            if (i > 48)
+            {
+                u64 see1 = seed, see2 = seed;
+                do
+                {
+                    seed = hash_mix(hash_read8(p) ^ s[1], hash_read8(p + 8) ^ seed);
+                    see1 = hash_mix(hash_read8(p + 16) ^ s[2], hash_read8(p + 24) ^ see1);
+                    see2 = hash_mix(hash_read8(p + 32) ^ s[3], hash_read8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                }
+                while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            for (; i > 16; i -= 16, p += 16)
+                seed = hash_mix(hash_read8(p) ^ s[1], hash_read8(p + 8) ^ seed);
+            a = hash_read8(p + i - 16);
+            b = hash_read8(p + i - 8);
+            return seed;
+        }
+
+        // wyhash: inputs up to 16 bytes are read as two overlapping words without a loop. This part stays small
+        // enough to inline, so a constant seed folds away. Words are read in native (little) endian order.
+        inline u64 hash_bytes(const u8* p, u64 n, u64 seed) noexcept
+        {
+            const u64* s = hash_secret;
+            seed ^= hash_mix(seed ^ s[0], s[1]);
+            u64 a, b;
+            if (n > 16)
+                seed = hash_long(p, n, seed, a, b);
+            else if (n >= 4)
+            {
+                const u64 shift = (n >> 3) << 2;
+                a = hash_read4(p) << 32 | hash_read4(p + shift);
+                b = hash_read4(p + n - 4) << 32 | hash_read4(p + n - 4 - shift);
+            }
+            else if (n)
+            {
+                a = u64(p[0]) << 16 | u64(p[n >> 1]) << 8 | p[n - 1];
+                b = 0;
+            }
+            else
+                a = b = 0;
+            a ^= s[1];
+            b ^= seed;
+            const hash_u128 r = static_cast<hash_u128>(a) * b;
+            return hash_mix(static_cast<u64>(r) ^ s[0] ^ n, static_cast<u64>(r >> 64) ^ s[1]);
+        }
+
+        template<typename Tp>
+        inline constexpr bool is_hash_string_v = std::is_convertible_v<const Tp&, std::string_view>;
+
+        template<typename Tp, typename = sfinae>
+        struct is_hash_contiguous : std::false_type { };
+
+        // Containers whose elements can be hashed as raw memory, equal values have equal bytes
+        template<typename Tp>
+        struct is_hash_contiguous<Tp, sfinae_t<decltype(std::data(std::declval<const Tp&>())), decltype(std::size(std::declval<const Tp&>()))>> :
+            constant<std::has_unique_object_representations_v<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<const Tp&>()))>>>> { };
+
+        template<typename Tp, typename = sfinae>
+        struct is_hash_tuple : std::false_type { };
+
+        template<typename Tp>
+        struct is_hash_tuple<Tp, sfinae_t<decltype(std::tuple_size<Tp>::value)>> : std::true_type { };
+
+        template<typename Tp>
+        inline constexpr bool is_hash_aggregate_v = std::is_aggregate_v<Tp> && !std::is_array_v<Tp> && !mt::is_iterable_v<const Tp&>;
+
+        // Members of an aggregate as a tuple of references. The count is the one struct_info reports, taken from its
+        // detail so member types need no registered type ids.
+        template<u64 N, typename Tp>
+        auto tie_members(const Tp& x) noexcept
+        {
+            static_assert (N >= 1 && N <= 12, "Aggregates of 1 to 12 members are supported");
+#define UF_TIE_MEMBERS(...) { const auto& [__VA_ARGS__] = x; return std::tie(__VA_ARGS__); }
+            if constexpr (N == 1) UF_TIE_MEMBERS(m1)
+            else if constexpr (N == 2) UF_TIE_MEMBERS(m1, m2)
+            else if constexpr (N == 3) UF_TIE_MEMBERS(m1, m2, m3)
+            else if constexpr (N == 4) UF_TIE_MEMBERS(m1, m2, m3, m4)
+            else if constexpr (N == 5) UF_TIE_MEMBERS(m1, m2, m3, m4, m5)
+            else if constexpr (N == 6) UF_TIE_MEMBERS(m1, m2, m3, m4, m5, m6)
+            else if constexpr (N == 7) UF_TIE_MEMBERS(m1, m2, m3, m4, m5, m6, m7)
+            else if constexpr (N == 8) UF_TIE_MEMBERS(m1, m2, m3, m4, m5, m6, m7, m8)
+            else if constexpr (N == 9) UF_TIE_MEMBERS(m1, m2, m3, m4, m5, m6, m7, m8, m9)
+            else if constexpr (N == 10) UF_TIE_MEMBERS(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10)
+            else if constexpr (N == 11) UF_TIE_MEMBERS(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11)
+            else UF_TIE_MEMBERS(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12)
+#undef UF_TIE_MEMBERS
+        }
+    }
+    // namespace detail
+
+    inline namespace hashing
+    {
+        inline u64 hash_bytes(span<const std::byte> data, u64 seed = 0) noexcept
+        {
+            return detail::hash_bytes(reinterpret_cast<const u8*>(data.data()), data.size(), seed);
+        }
+
+        // Same value as hash_bytes over the characters
+        inline u64 hash_string(std::string_view s, u64 seed = 0) noexcept
+        {
+            return detail::hash_bytes(reinterpret_cast<const u8*>(s.data()), s.size(), seed);
+        }
+
+        // Hash of any of: string-likes (all of them hash alike, so std::string, string_view and literals agree),
+        // arithmetic types, enums and pointers, tuple-likes and ranges element by element, and aggregates member by
+        // member. Contiguous ranges of types without padding are hashed as bytes. Anything else goes through
+        // std::hash. The seed chains values, hash_value(b, hash_value(a)) hashes the pair.
+        template<typename Tp>
+        u64 hash_value(const Tp& value, u64 seed = 0) noexcept
+        {
+            if constexpr (detail::is_hash_string_v<Tp>)
+                return hash_string(std::string_view(value), seed);
+            else if constexpr (std::is_integral_v<Tp> || std::is_enum_v<Tp> || std::is_pointer_v<Tp>)
+            {
+                u64 bits;
+                if constexpr (std::is_pointer_v<Tp>)
+                    bits = reinterpret_cast<std::uintptr_t>(value);
+                else
+                    bits = static_cast<u64>(value);
+                return detail::hash_mix(bits ^ detail::hash_secret[0], seed ^ detail::hash_secret[1]);
+            }
+            else if constexpr (std::is_floating_point_v<Tp>)
+            {
+                // -0.0 equals 0.0 and must hash alike
+                const double normalized = value == 0 ? 0.0 : static_cast<double>(value);
+                u64 bits;
+                std::memcpy(&bits, &normalized, sizeof(bits));
+                return hash_value(bits, seed);
+            }
+            else if constexpr (std::is_same_v<Tp, std::nullptr_t>)
+                return hash_value(u64(0), seed);
+            else if constexpr (mt::is_instantiated_from_v<std::optional, Tp>)
+                return value ? hash_value(*value, hash_value(u64(1), seed)) : hash_value(u64(0), seed);
+            else if constexpr (detail::is_hash_contiguous<Tp>::value)
+                return detail::hash_bytes(reinterpret_cast<const u8*>(std::data(value)), std::size(value) * sizeof(*std::data(value)), seed);
+            else if constexpr (mt::is_iterable_v<const Tp&>)
+            {
+                u64 count = 0;
+                for (const auto& element : value)
+                {
+                    seed = hash_value(element, seed);
+                    ++count;
+                }
+                return hash_value(count, seed);
+            }
+            else if constexpr (detail::is_hash_tuple<Tp>::value)
+            {
+                std::apply([&seed](const auto&... members) { ((seed = hash_value(members, seed)), ...); }, value);
+                return seed;
+            }
+            else if constexpr (detail::is_hash_aggregate_v<Tp>)
+                return hash_value(detail::tie_members<mt::detail::struct_members_number<Tp>::value>(value), seed);
+            else
+                return hash_value(static_cast<u64>(std::hash<Tp>()(value)), seed);
+        }
+
+        // Transparent functors: in containers that support heterogeneous lookup a std::string key is found by a
+        // string_view or a literal without building a std::string
+        struct hash
+        {
+            using is_transparent = void;
+
+            template<typename Tp>
+            u64 operator()(const Tp& value) const noexcept
+            {
+                return hash_value(value);
+            }
+        };
+
+        struct equal_to
+        {
+            using is_transparent = void;
+
+            template<typename Tp1, typename Tp2>
+            bool operator()(const Tp1& a, const Tp2& b) const
+            {
+                if constexpr (detail::is_hash_string_v<Tp1> && detail::is_hash_string_v<Tp2>)
+                    return std::string_view(a) == std::string_view(b);
+                else
+                    return a == b;
+            }
+        };
+    }
+    // inline namespace hashing
+}
+// namespace uf
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstring>
 
+#include <array>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -14,6 +15,7 @@
 #include <queue>
 #include <deque>
 #include <iterator>
+#include <memory>
 
 #include <iostream>
 #include <fstream>
@@ -30,7 +32,7 @@
 #include <any>
 #include <numeric>
 #include <algorithm>
-// TODO: #include <charconv>
+#include <charconv>
 
 #include "base.hpp"
 
@@ -0,0 +1,240 @@
+#pragma once
+#include "span.hpp"
+
+namespace uf
+{
+    inline namespace matcher
+    {
+        // Aho-Corasick automaton over bytes. Transitions live in a double array (state t is the child of s on byte c
+        // when t == base[s] + c and check[t] == s), the root keeps a dense table, so the hot loop touches a few
+        // small arrays and never allocates. The tables are immutable and shared between copies, so a matcher is
+        // cheap to copy into predicates such as stf_any_obj.
+        class multi_matcher
+        {
+        public:
+            struct match
+            {
+                u64 pattern;
+                u64 begin;
+                u64 end;
+
+                bool operator==(const match& other) const noexcept
+                {
+                    return pattern == other.pattern && begin == other.begin && end == other.end;
+                }
+            };
+
+        private:
+            static constexpr i32 none = -1;
+
+            struct automaton
+            {
+                std::array<i32, 256> m_root{};
+                std::vector<i32> m_base;
+                std::vector<i32> m_check;
+                std::vector<i32> m_fail;
+                std::vector<i32> m_dict;
+                std::vector<i32> m_report;
+                std::vector<u32> m_out_begin;
+                std::vector<u32> m_outputs;
+                std::vector<u64> m_lengths;
+
+                i32 next(i32 s, u8 c) const noexcept
+                {
+                    for (;;)
+                    {
+                        if (!s)
+                            return m_root[c];
+                        const u64 t = static_cast<u64>(m_base[s]) + c;
+                        if (m_check[t] == s)
+                            return static_cast<i32>(t);
+                        s = m_fail[s];
+                    }
+                }
+
+                void build(const std::vector<std::string_view>& patterns)
+                {
+                    // Plain trie first, its children lists are sorted by byte
+                    std::vector<std::vector<std::pair<u8, u32>>> trie(1);
+                    std::vector<std::vector<u32>> ends(1);
+                    for (u64 id = 0; id < patterns.size(); ++id)
+                    {
+                        m_lengths.push_back(patterns[id].size());
+                        u32 node = 0;
+                        for (char ch : patterns[id])
+                        {
+                            const u8 c = static_cast<u8>(ch);
+                            auto& children = trie[node];
+                            auto i = std::lower_bound(children.begin(), children.end(), std::pair<u8, u32>(c, 0));
+                            if (i == children.end() || i->first != c)
+                            {
+                                i = children.insert(i, {c, static_cast<u32>(trie.size())});
+                                trie.emplace_back();
+                                ends.emplace_back();
+                            }
+                            node = i->second;
+                        }
+                        ends[node].push_back(static_cast<u32>(id));
+                    }
+
+                    // Place nodes into the double array breadth first
+                    m_base.assign(1, 0);
+                    m_check.assign(1, none);
+                    std::vector<i32> index(trie.size(), 0);
+                    std::vector<u32> order{0};
+                    u64 first_free = 1;
+                    for (u64 q = 0; q < order.size(); ++q)
+                    {
+                        const u32 node = order[q];
+                        const auto& children = trie[node];
+                        if (children.empty())
+                            continue;
+                        while (first_free < m_check.size() && m_check[first_free] != none)
+                            ++first_free;
+                        u64 base = first_free > children.front().first ? first_free - children.front().first : 1;
+                        for (;; ++base)
+                        {
+                            bool fits = true;
+                            for (const auto& [c, ignored] : children)
+                                fits = fits && (base + c >= m_check.size() || m_check[base + c] == none);
+                            if (fits)
+                                break;
+                        }
+                        const u64 required = base + children.back().first + 1;
+                        if (required > m_check.size())
+                        {
+                            m_check.resize(required, none);
+                            m_base.resize(required, 0);
+                        }
+                        m_base[index[node]] = static_cast<i32>(base);
+                        for (const auto& [c, to] : children)
+                        {
+                            index[to] = static_cast<i32>(base + c);
+                            m_check[base + c] = index[node];
+                            order.push_back(to);
+                        }
+                    }
+                    for (const auto& [c, to] : trie[0])
+                        m_root[c] = index[to];
+
+                    // Padding past the last state keeps base[s] + c in bounds without a check in the hot loop
+                    const u64 states = m_check.size();
+                    const i32 max_base = *std::max_element(m_base.begin(), m_base.end());
+                    m_check.resize(std::max<u64>(states, max_base + 256), none);
+                    m_base.resize(states);
+                    m_out_begin.assign(states + 1, 0);
+                    for (u64 node = 0; node < trie.size(); ++node)
+                        m_out_begin[index[node] + 1] = static_cast<u32>(ends[node].size());
+                    std::partial_sum(m_out_begin.begin(), m_out_begin.end(), m_out_begin.begin());
+                    m_outputs.resize(m_out_begin.back());
+                    for (u64 node = 0; node < trie.size(); ++node)
+                        std::copy(ends[node].begin(), ends[node].end(), m_outputs.begin() + m_out_begin[index[node]]);
+
+                    // Failure and dictionary links, breadth first order handles parents before children
+                    m_fail.assign(states, 0);
+                    m_dict.assign(states, none);
+                    for (u32 node : order)
+                    {
+                        const i32 s = index[node];
+                        for (const auto& [c, to] : trie[node])
+                        {
+                            const i32 t = index[to];
+                            const i32 f = s ? next(m_fail[s], c) : 0;
+                            m_fail[t] = f;
+                            m_dict[t] = m_out_begin[f + 1] > m_out_begin[f] ? f : m_dict[f];
+                        }
+                    }
+                    m_report.resize(states);
+                    for (u64 t = 0; t < states; ++t)
+                        m_report[t] = m_out_begin[t + 1] > m_out_begin[t] ? static_cast<i32>(t) : m_dict[t];
+                }
+            };
+
+            std::shared_ptr<const automaton> m_automaton;
+
+            static std::shared_ptr<const automaton> make_automaton(const std::vector<std::string_view>& patterns)
+            {
+                auto result = std::make_shared<automaton>();
+                result->build(patterns);
+                return result;
+            }
+
+        public:
+            multi_matcher() : m_automaton(make_automaton({})) { }
+
+            template<class Patterns>
+            explicit multi_matcher(const Patterns& patterns)
+            {
+                std::vector<std::string_view> views;
+                for (const auto& p : patterns)
+                    views.emplace_back(p);
+                m_automaton = make_automaton(views);
+            }
+
+            multi_matcher(std::initializer_list<std::string_view> patterns) : m_automaton(make_automaton(std::vector<std::string_view>(patterns))) { }
+
+            u64 size() const noexcept
+            {
+                return m_automaton->m_lengths.size();
+            }
+
+            // Calls f(match) for every occurrence of every pattern in the order of match ends, stops early when f
+            // returns false
+            template<class F>
+            void for_each_match(span<const char> text, F&& f) const
+            {
+                const automaton& a = *m_automaton;
+                const auto report = [&](u64 pattern, u64 end)
+                {
+                    if constexpr (std::is_same_v<std::invoke_result_t<F&, const match&>, bool>)
+                        return std::invoke(f, match{pattern, end - a.m_lengths[pattern], end});
+                    else
+                    {
+                        std::invoke(f, match{pattern, end - a.m_lengths[pattern], end});
+                        return true;
+                    }
+                };
+
+                i32 s = 0;
+                for (u64 i = 0; i <= text.size(); ++i)
+                {
+                    for (i32 o = a.m_report[s]; o != none; o = o ? a.m_dict[o] : none)
+                        for (u32 k = a.m_out_begin[o]; k < a.m_out_begin[o + 1]; ++k)
+                            if (!report(a.m_outputs[k], i))
+                                return;
+                    if (i == text.size())
+                        break;
+                    s = a.next(s, static_cast<u8>(text[i]));
+                }
+            }
+
+            std::vector<match> find_all(span<const char> text) const
+            {
+                std::vector<match> result;
+                for_each_match(text, [&result](const match& m){ result.push_back(m); });
+                return result;
+            }
+
+            bool contains_any(span<const char> text) const
+            {
+                bool result = false;
+                for_each_match(text, [&result](const match&){ result = true; return false; });
+                return result;
+            }
+
+            // Predicate form for stf_any, remove_associative and split: a string matches when it contains any
+            // pattern, a single char when it is one of the patterns
+            bool operator()(std::string_view text) const
+            {
+                return contains_any(span<const char>(text.data(), text.size()));
+            }
+
+            bool operator()(char c) const
+            {
+                return contains_any(span<const char>(&c, 1));
+            }
+        };
+    }
+    // inline namespace matcher
+}
+// namespace uf
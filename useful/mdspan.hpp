@@ -0,0 +1,485 @@
+#pragma once
+#include "span.hpp"
+
+namespace uf
+{
+    inline namespace multidim
+    {
+        template<u64... Es>
+        class extents;
+    }
+    // inline namespace multidim
+
+    namespace detail
+    {
+        template<u64>
+        inline constexpr u64 always_dynamic = dynamic_extent;
+
+        template<u64 Rank, typename Sequence = std::make_index_sequence<Rank>>
+        struct make_dextents;
+
+        template<u64 Rank, u64... Is>
+        struct make_dextents<Rank, std::index_sequence<Is...>>
+        {
+            using type = extents<always_dynamic<Is>...>;
+        };
+
+        template<typename Extents, u64... Is>
+        constexpr Extents extents_from(const std::array<u64, Extents::rank()>& sizes, std::index_sequence<Is...>) noexcept
+        {
+            std::array<u64, Extents::rank_dynamic()> dynamic{};
+            u64 d = 0;
+            ((Extents::static_extent(Is) == dynamic_extent ? void(dynamic[d++] = sizes[Is]) : void()), ...);
+            return Extents(dynamic);
+        }
+
+        // Rebuilds Extents from all of its sizes, static ones must match
+        template<typename Extents>
+        constexpr Extents extents_from(const std::array<u64, Extents::rank()>& sizes) noexcept
+        {
+            return extents_from<Extents>(sizes, std::make_index_sequence<Extents::rank()>());
+        }
+
+        template<typename F, u64 Rank>
+        void for_each_index(const std::array<u64, Rank>& sizes, std::array<u64, Rank>& index, u64 r, F& f)
+        {
+            for (index[r] = 0; index[r] < sizes[r]; ++index[r])
+            {
+                if (r + 1 == Rank)
+                    f(std::as_const(index));
+                else
+                    for_each_index(sizes, index, r + 1, f);
+            }
+        }
+    }
+    // namespace detail
+
+    inline namespace multidim
+    {
+        // Sizes of the dimensions, each static or dynamic_extent. Only the dynamic ones are stored.
+        template<u64... Es>
+        class extents
+        {
+            static_assert (sizeof...(Es) >= 1, "extents: Rank must be at least one");
+
+            static constexpr u64 m_static[] = {Es...};
+            static constexpr u64 m_rank_dynamic = ((Es == dynamic_extent) + ...);
+
+            std::array<u64, m_rank_dynamic> m_dynamic{};
+
+            static constexpr u64 dynamic_index(u64 r) noexcept
+            {
+                u64 result = 0;
+                for (u64 i = 0; i < r; ++i)
+                    result += m_static[i] == dynamic_extent;
+                return result;
+            }
+
+        public:
+            constexpr extents() noexcept = default;
+
+            // The dynamic extents in order
+            template<typename... Sizes, typename = std::enable_if_t<sizeof...(Sizes) == m_rank_dynamic && (sizeof...(Sizes) > 0) && (std::is_integral_v<Sizes> && ...)>>
+            constexpr explicit extents(Sizes... sizes) noexcept : m_dynamic{static_cast<u64>(sizes)...} { }
+
+            constexpr explicit extents(const std::array<u64, m_rank_dynamic>& sizes) noexcept : m_dynamic(sizes) { }
+
+            static constexpr u64 rank() noexcept
+            {
+                return sizeof...(Es);
+            }
+
+            static constexpr u64 rank_dynamic() noexcept
+            {
+                return m_rank_dynamic;
+            }
+
+            static constexpr u64 static_extent(u64 r) noexcept
+            {
+                return m_static[r];
+            }
+
+            constexpr u64 extent(u64 r) const noexcept
+            {
+                return m_static[r] == dynamic_extent ? m_dynamic[dynamic_index(r)] : m_static[r];
+            }
+
+            // Number of elements
+            constexpr u64 size() const noexcept
+            {
+                u64 result = 1;
+                for (u64 r = 0; r < rank(); ++r)
+                    result *= extent(r);
+                return result;
+            }
+
+            template<u64... Os>
+            constexpr bool operator==(const extents<Os...>& other) const noexcept
+            {
+                if constexpr (sizeof...(Os) != sizeof...(Es))
+                    return false;
+                else
+                {
+                    for (u64 r = 0; r < rank(); ++r)
+                        if (extent(r) != other.extent(r))
+                            return false;
+                    return true;
+                }
+            }
+        };
+
+        template<u64 Rank>
+        using dextents = typename detail::make_dextents<Rank>::type;
+
+        // Row-major: the last index is contiguous
+        struct layout_right
+        {
+            template<typename Extents>
+            class mapping
+            {
+                Extents m_extents;
+
+            public:
+                using extents_type = Extents;
+
+                constexpr mapping() noexcept = default;
+                constexpr explicit mapping(const Extents& e) noexcept : m_extents(e) { }
+
+                constexpr const Extents& extents() const noexcept
+                {
+                    return m_extents;
+                }
+
+                constexpr u64 stride(u64 r) const noexcept
+                {
+                    u64 result = 1;
+                    for (u64 i = r + 1; i < Extents::rank(); ++i)
+                        result *= m_extents.extent(i);
+                    return result;
+                }
+
+                constexpr u64 required_span_size() const noexcept
+                {
+                    return m_extents.size();
+                }
+
+                constexpr u64 operator()(const std::array<u64, Extents::rank()>& index) const noexcept
+                {
+                    u64 result = 0;
+                    for (u64 r = 0; r < Extents::rank(); ++r)
+                        result = result * m_extents.extent(r) + index[r];
+                    return result;
+                }
+            };
+        };
+
+        // Column-major: the first index is contiguous
+        struct layout_left
+        {
+            template<typename Extents>
+            class mapping
+            {
+                Extents m_extents;
+
+            public:
+                using extents_type = Extents;
+
+                constexpr mapping() noexcept = default;
+                constexpr explicit mapping(const Extents& e) noexcept : m_extents(e) { }
+
+                constexpr const Extents& extents() const noexcept
+                {
+                    return m_extents;
+                }
+
+                constexpr u64 stride(u64 r) const noexcept
+                {
+                    u64 result = 1;
+                    for (u64 i = 0; i < r; ++i)
+                        result *= m_extents.extent(i);
+                    return result;
+                }
+
+                constexpr u64 required_span_size() const noexcept
+                {
+                    return m_extents.size();
+                }
+
+                constexpr u64 operator()(const std::array<u64, Extents::rank()>& index) const noexcept
+                {
+                    u64 result = 0;
+                    for (u64 r = Extents::rank(); r--;)
+                        result = result * m_extents.extent(r) + index[r];
+                    return result;
+                }
+            };
+        };
+
+        // Any stride per dimension, in elements. Slices of the other layouts take this one.
+        struct layout_stride
+        {
+            template<typename Extents>
+            class mapping
+            {
+                Extents m_extents;
+                std::array<u64, Extents::rank()> m_strides{};
+
+            public:
+                using extents_type = Extents;
+
+                constexpr mapping() noexcept = default;
+
+                constexpr mapping(const Extents& e, const std::array<u64, Extents::rank()>& strides) noexcept : m_extents(e), m_strides(strides) { }
+
+                constexpr const Extents& extents() const noexcept
+                {
+                    return m_extents;
+                }
+
+                constexpr u64 stride(u64 r) const noexcept
+                {
+                    return m_strides[r];
+                }
+
+                // One past the furthest element, 0 if any extent is 0
+                constexpr u64 required_span_size() const noexcept
+                {
+                    u64 result = 1;
+                    for (u64 r = 0; r < Extents::rank(); ++r)
+                    {
+                        if (!m_extents.extent(r))
+                            return 0;
+                        result += (m_extents.extent(r) - 1) * m_strides[r];
+                    }
+                    return result;
+                }
+
+                constexpr u64 operator()(const std::array<u64, Extents::rank()>& index) const noexcept
+                {
+                    u64 result = 0;
+                    for (u64 r = 0; r < Extents::rank(); ++r)
+                        result += index[r] * m_strides[r];
+                    return result;
+                }
+            };
+        };
+
+        // Matrices stored as TileRows x TileCols blocks, tiles in row-major order and elements row-major within a
+        // tile. Scans in either direction stay within a few pages per tile. Partial tiles at the edges are padded,
+        // so the storage holds required_span_size() elements rather than size().
+        template<u64 TileRows, u64 TileCols>
+        struct layout_tiled
+        {
+            static_assert (TileRows && TileCols, "layout_tiled: Tile dimensions must be positive");
+
+            template<typename Extents>
+            class mapping
+            {
+                static_assert (Extents::rank() == 2, "layout_tiled: Only matrices are tiled");
+
+                static constexpr u64 m_tile_size = TileRows * TileCols;
+
+                Extents m_extents;
+                u64 m_tiles_per_row;
+
+            public:
+                using extents_type = Extents;
+
+                constexpr mapping() noexcept : mapping(Extents()) { }
+
+                constexpr explicit mapping(const Extents& e) noexcept :
+                    m_extents(e),
+                    m_tiles_per_row((e.extent(1) + TileCols - 1) / TileCols) { }
+
+                constexpr const Extents& extents() const noexcept
+                {
+                    return m_extents;
+                }
+
+                constexpr u64 required_span_size() const noexcept
+                {
+                    return (m_extents.extent(0) + TileRows - 1) / TileRows * m_tiles_per_row * m_tile_size;
+                }
+
+                constexpr u64 operator()(const std::array<u64, 2>& index) const noexcept
+                {
+                    const u64 tile = index[0] / TileRows * m_tiles_per_row + index[1] / TileCols;
+                    return tile * m_tile_size + index[0] % TileRows * TileCols + index[1] % TileCols;
+                }
+            };
+        };
+
+        // Non-owning multidimensional view over contiguous storage, Layout decides where each index lives
+        template<typename Tp, typename Extents, typename Layout = layout_right>
+        class mdspan
+        {
+        public:
+            using value_type = Tp;
+            using pointer = value_type*;
+            using reference = value_type&;
+            using extents_type = Extents;
+            using layout_type = Layout;
+            using mapping_type = typename Layout::template mapping<Extents>;
+            using index_type = std::array<u64, Extents::rank()>;
+
+        private:
+            pointer m_data = nullptr;
+            mapping_type m_mapping;
+
+        public:
+            constexpr mdspan() noexcept = default;
+
+            constexpr mdspan(pointer data, const mapping_type& m) noexcept : m_data(data), m_mapping(m) { }
+
+            constexpr mdspan(pointer data, const Extents& e) noexcept : m_data(data), m_mapping(e) { }
+
+            // The dynamic extents in order
+            template<typename... Sizes, typename = std::enable_if_t<sizeof...(Sizes) == Extents::rank_dynamic() && (std::is_integral_v<Sizes> && ...)>>
+            constexpr explicit mdspan(pointer data, Sizes... sizes) noexcept : mdspan(data, Extents(sizes...)) { }
+
+            // Over a container with at least required_span_size() elements, throws if it is shorter
+            template<typename... Sizes, typename = std::enable_if_t<sizeof...(Sizes) == Extents::rank_dynamic() && (std::is_integral_v<Sizes> && ...)>>
+            mdspan(span<Tp> storage, Sizes... sizes) : mdspan(storage.data(), Extents(sizes...))
+            {
+                if (storage.size() < m_mapping.required_span_size())
+                    throw std::out_of_range("mdspan::mdspan: Storage of " + std::to_string(storage.size()) + " elements, " +
+                                            std::to_string(m_mapping.required_span_size()) + " required");
+            }
+
+            // From a view with the same element layout, e.g. to a view of const
+            template<typename Up, typename = std::enable_if_t<std::is_convertible_v<Up(*)[], Tp(*)[]>>>
+            constexpr mdspan(const mdspan<Up, Extents, Layout>& other) noexcept : m_data(other.data()), m_mapping(other.mapping()) { }
+
+            static constexpr u64 rank() noexcept
+            {
+                return Extents::rank();
+            }
+
+            constexpr u64 extent(u64 r) const noexcept
+            {
+                return m_mapping.extents().extent(r);
+            }
+
+            constexpr const Extents& extents() const noexcept
+            {
+                return m_mapping.extents();
+            }
+
+            // Number of elements, the storage may be larger
+            constexpr u64 size() const noexcept
+            {
+                return m_mapping.extents().size();
+            }
+
+            constexpr bool empty() const noexcept
+            {
+                return !size();
+            }
+
+            constexpr u64 stride(u64 r) const noexcept
+            {
+                return m_mapping.stride(r);
+            }
+
+            constexpr pointer data() const noexcept
+            {
+                return m_data;
+            }
+
+            constexpr const mapping_type& mapping() const noexcept
+            {
+                return m_mapping;
+            }
+
+            // The storage the view spans
+            constexpr span<Tp> storage() const noexcept
+            {
+                return span<Tp>(m_data, m_mapping.required_span_size());
+            }
+
+            constexpr reference operator[](const index_type& index) const noexcept
+            {
+                return m_data[m_mapping(index)];
+            }
+
+            template<typename... Is, typename = std::enable_if_t<sizeof...(Is) == Extents::rank() && (std::is_integral_v<Is> && ...)>>
+            constexpr reference operator()(Is... is) const noexcept
+            {
+                return m_data[m_mapping(index_type{static_cast<u64>(is)...})];
+            }
+
+            template<typename... Is, typename = std::enable_if_t<sizeof...(Is) == Extents::rank() && (std::is_integral_v<Is> && ...)>>
+            constexpr reference at(Is... is) const
+            {
+                const index_type index{static_cast<u64>(is)...};
+                for (u64 r = 0; r < rank(); ++r)
+                    if (index[r] >= extent(r))
+                        throw std::out_of_range("mdspan: Out of range, index = " + std::to_string(index[r]) + " in dimension " +
+                                                std::to_string(r) + ", but extent = " + std::to_string(extent(r)));
+                return operator[](index);
+            }
+
+            // Elements first[r] to first[r] + count[r] of every dimension, clamped like span::subspan. Shares the
+            // storage through strides, so only layouts with a stride per dimension can be sliced.
+            constexpr mdspan<Tp, dextents<Extents::rank()>, layout_stride> slice(const index_type& first, const index_type& count) const noexcept
+            {
+                index_type start{}, sizes{}, strides{};
+                bool empty = false;
+                for (u64 r = 0; r < rank(); ++r)
+                {
+                    start[r] = std::min(first[r], extent(r));
+                    sizes[r] = std::min(count[r], extent(r) - start[r]);
+                    strides[r] = stride(r);
+                    empty |= !sizes[r];
+                }
+                using result_mapping = layout_stride::mapping<dextents<Extents::rank()>>;
+                return {m_data + (empty ? 0 : m_mapping(start)), result_mapping(detail::extents_from<dextents<Extents::rank()>>(sizes), strides)};
+            }
+
+            // rows x cols block of a matrix starting at (row, col)
+            constexpr auto submatrix(u64 row, u64 col, u64 rows, u64 cols) const noexcept
+            {
+                static_assert (Extents::rank() == 2, "mdspan::submatrix: Only for matrices");
+                return slice({row, col}, {rows, cols});
+            }
+
+            // Row i or column j of a matrix as a one-dimensional strided view
+            constexpr mdspan<Tp, dextents<1>, layout_stride> row(u64 i) const noexcept
+            {
+                static_assert (Extents::rank() == 2, "mdspan::row: Only for matrices");
+                return {m_data + m_mapping(index_type{i, 0}), layout_stride::mapping<dextents<1>>(dextents<1>(extent(1)), {stride(1)})};
+            }
+
+            constexpr mdspan<Tp, dextents<1>, layout_stride> column(u64 j) const noexcept
+            {
+                static_assert (Extents::rank() == 2, "mdspan::column: Only for matrices");
+                return {m_data + m_mapping(index_type{0, j}), layout_stride::mapping<dextents<1>>(dextents<1>(extent(0)), {stride(0)})};
+            }
+        };
+
+        // Calls f with every index of the extents, the last dimension fastest
+        template<typename Extents, typename F>
+        void for_each_index(const Extents& e, F&& f)
+        {
+            std::array<u64, Extents::rank()> sizes{}, index{};
+            for (u64 r = 0; r < Extents::rank(); ++r)
+            {
+                if (!e.extent(r))
+                    return;
+                sizes[r] = e.extent(r);
+            }
+            detail::for_each_index(sizes, index, 0, f);
+        }
+
+        // Copies between views of equal extents and any layouts, e.g. to re-tile a row-major matrix
+        template<typename Tp, typename Up, typename E1, typename E2, typename L1, typename L2>
+        void copy(const mdspan<Tp, E1, L1>& from, const mdspan<Up, E2, L2>& to)
+        {
+            if (!(from.extents() == to.extents()))
+                throw std::invalid_argument("copy: Views have different extents");
+            for_each_index(from.extents(), [&](const auto& index) { to[index] = from[index]; });
+        }
+    }
+    // inline namespace multidim
+}
+// namespace uf
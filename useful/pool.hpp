@@ -0,0 +1,224 @@
+#pragma once
+#include <mutex>
+#include <shared_mutex>
+
+#include "strings.hpp"
+#include "hash.hpp"
+
+namespace uf
+{
+    inline namespace pool
+    {
+        // Deduplicated store of strings. Every distinct string is copied once into an arena and gets a dense 32-bit
+        // symbol, so equal strings compare by symbol and their views never move or dangle while the pool lives.
+        class string_pool
+        {
+        public:
+            using symbol = u32;
+
+            static constexpr symbol npos = std::numeric_limits<symbol>::max();
+
+        private:
+            monotonic_arena m_arena;
+            std::vector<std::string_view> m_strings;
+            std::vector<u64> m_hashes;
+            // Open addressing table of symbol + 1, zero marks an empty slot
+            std::vector<symbol> m_slots;
+
+            static u64 hash_of(std::string_view s) noexcept
+            {
+                return hash_string(s);
+            }
+
+            u64 slot_of(std::string_view s, u64 hash) const noexcept
+            {
+                const u64 mask = m_slots.size() - 1;
+                for (u64 i = hash & mask;; i = (i + 1) & mask)
+                {
+                    const symbol entry = m_slots[i];
+                    if (!entry || (m_hashes[entry - 1] == hash && m_strings[entry - 1] == s))
+                        return i;
+                }
+            }
+
+            void grow()
+            {
+                std::vector<symbol> slots(std::max<u64>(16, m_slots.size() * 2), 0);
+                const u64 mask = slots.size() - 1;
+                for (symbol id = 0; id < m_strings.size(); ++id)
+                {
+                    u64 i = m_hashes[id] & mask;
+                    while (slots[i])
+                        i = (i + 1) & mask;
+                    slots[i] = id + 1;
+                }
+                m_slots = std::move(slots);
+            }
+
+        public:
+            explicit string_pool(u64 block_size = monotonic_arena::default_block_size) : m_arena(block_size) { }
+
+            // Symbol of s, s is copied into the pool the first time it is seen
+            symbol intern(std::string_view s)
+            {
+                return intern(s, hash_of(s));
+            }
+
+            // Same with a hash computed by the caller, it must come from the same function for every call. New
+            // symbols must be below limit, otherwise std::length_error is thrown before anything is stored.
+            symbol intern(std::string_view s, u64 hash, symbol limit = npos)
+            {
+                // Load factor stays at most one half
+                if ((m_strings.size() + 1) * 2 > m_slots.size())
+                    grow();
+                const u64 i = slot_of(s, hash);
+                if (m_slots[i])
+                    return m_slots[i] - 1;
+                if (m_strings.size() >= limit)
+                    throw std::length_error("string_pool::intern: Out of symbols");
+                m_strings.push_back(m_arena.store(s));
+                m_hashes.push_back(hash);
+                m_slots[i] = static_cast<symbol>(m_strings.size());
+                return m_slots[i] - 1;
+            }
+
+            // The pooled copy of s, stable for the lifetime of the pool
+            std::string_view intern_view(std::string_view s)
+            {
+                return view(intern(s));
+            }
+
+            // Symbol of s or npos if it was never interned
+            symbol find(std::string_view s) const noexcept
+            {
+                return find(s, hash_of(s));
+            }
+
+            symbol find(std::string_view s, u64 hash) const noexcept
+            {
+                if (m_slots.empty())
+                    return npos;
+                const symbol entry = m_slots[slot_of(s, hash)];
+                return entry ? entry - 1 : npos;
+            }
+
+            std::string_view view(symbol id) const noexcept
+            {
+                return m_strings[id];
+            }
+
+            u64 size() const noexcept
+            {
+                return m_strings.size();
+            }
+
+            // Bytes held by the arena, the symbol table and the hash table
+            u64 memory() const noexcept
+            {
+                return m_arena.capacity() + m_strings.capacity() * (sizeof(std::string_view) + sizeof(u64)) + m_slots.capacity() * sizeof(symbol);
+            }
+        };
+
+        // Thread-safe pool split into shards by hash, lookups of known strings only take a shared lock. The low bits
+        // of a symbol select the shard.
+        class concurrent_string_pool
+        {
+        public:
+            using symbol = string_pool::symbol;
+
+            static constexpr symbol npos = string_pool::npos;
+
+        private:
+            struct shard
+            {
+                mutable std::shared_mutex mutex;
+                string_pool pool;
+            };
+
+            std::unique_ptr<shard[]> m_shards;
+            u32 m_shard_bits;
+
+            static u64 hash_of(std::string_view s) noexcept
+            {
+                return hash_string(s);
+            }
+
+            // The table index uses the low bits of the hash, the shard takes the high ones
+            u32 shard_of(u64 hash) const noexcept
+            {
+                return m_shard_bits ? static_cast<u32>(hash >> (64 - m_shard_bits)) : 0;
+            }
+
+        public:
+            // shard_count is rounded up to a power of two
+            explicit concurrent_string_pool(u32 shard_count = 16) : m_shard_bits(0)
+            {
+                while ((u32(1) << m_shard_bits) < shard_count)
+                    ++m_shard_bits;
+                m_shards = std::make_unique<shard[]>(u64(1) << m_shard_bits);
+            }
+
+            symbol intern(std::string_view s)
+            {
+                const u64 hash = hash_of(s);
+                shard& sh = m_shards[shard_of(hash)];
+                symbol local;
+                {
+                    std::shared_lock lock(sh.mutex);
+                    local = sh.pool.find(s, hash);
+                }
+                if (local == npos)
+                {
+                    // Local symbols must leave room for the shard bits, checked before the string is stored
+                    std::unique_lock lock(sh.mutex);
+                    local = sh.pool.intern(s, hash, npos >> m_shard_bits);
+                }
+                return local << m_shard_bits | shard_of(hash);
+            }
+
+            std::string_view intern_view(std::string_view s)
+            {
+                return view(intern(s));
+            }
+
+            symbol find(std::string_view s) const
+            {
+                const u64 hash = hash_of(s);
+                const shard& sh = m_shards[shard_of(hash)];
+                std::shared_lock lock(sh.mutex);
+                const symbol local = sh.pool.find(s, hash);
+                return local == npos ? npos : local << m_shard_bits | shard_of(hash);
+            }
+
+            std::string_view view(symbol id) const
+            {
+                const shard& sh = m_shards[id & ((u32(1) << m_shard_bits) - 1)];
+                std::shared_lock lock(sh.mutex);
+                return sh.pool.view(id >> m_shard_bits);
+            }
+
+            u64 size() const
+            {
+                u64 result = 0;
+                for (u64 i = 0; i < (u64(1) << m_shard_bits); ++i)
+                {
+                    std::shared_lock lock(m_shards[i].mutex);
+                    result += m_shards[i].pool.size();
+                }
+                return result;
+            }
+        };
+
+        // Splits like split() but returns the symbols of the tokens, repeated tokens share one pooled copy
+        template<class Pool, class SeqContainer, typename... Ds>
+        std::vector<typename Pool::symbol> split_symbols(Pool& pool, const SeqContainer& c, Ds&&... ds)
+        {
+            std::vector<typename Pool::symbol> result;
+            for (const auto& token : split_view(span<const char>(c.data(), c.size()), std::forward<Ds>(ds)...))
+                result.push_back(pool.intern(std::string_view(token.data(), token.size())));
+            return result;
+        }
+    }
+    // inline namespace pool
+}
+// namespace uf
@@ -0,0 +1,292 @@
+#pragma once
+#include "utils.hpp"
+#include "simd.hpp"
+
+namespace uf
+{
+    namespace detail
+    {
+        inline constexpr u64 npos = std::numeric_limits<u64>::max();
+
+        // Without vector instructions, needles at least this long are searched with Horspool skips. With them the
+        // first/last byte filter is faster at every needle length on text-like input, so it is always used.
+        inline constexpr u64 horspool_threshold = 16;
+
+        using horspool_table = std::array<u64, 256>;
+
+        inline void build_horspool_table(const char* s, u64 k, horspool_table& shift) noexcept
+        {
+            shift.fill(k);
+            for (u64 j = 0; j + 1 < k; ++j)
+                shift[static_cast<u8>(s[j])] = k - 1 - j;
+        }
+
+        inline u64 find_horspool(const char* h, u64 n, const char* s, u64 k, const horspool_table& shift) noexcept
+        {
+            const char last = s[k - 1];
+            for (u64 i = 0; i + k <= n;)
+            {
+                const char c = h[i + k - 1];
+                if (c == last && !std::memcmp(h + i, s, k - 1))
+                    return i;
+                i += shift[static_cast<u8>(c)];
+            }
+            return npos;
+        }
+
+        inline u64 find_filtered_scalar(const char* h, u64 n, const char* s, u64 k, u64 from) noexcept
+        {
+            const char first = s[0];
+            const char last = s[k - 1];
+            for (u64 i = from; i + k <= n; ++i)
+                if (h[i] == first && h[i + k - 1] == last && !std::memcmp(h + i + 1, s + 1, k - 2))
+                    return i;
+            return npos;
+        }
+
+        // The vector kernels compare the first and the last needle byte against a whole block of candidate positions,
+        // only the positions where both match are verified with memcmp. They stop where a full block no longer fits
+        // and report that position through scanned.
+#ifdef UF_SIMD_X86
+        UF_TARGET("sse2") inline u64 find_filtered_sse2(const char* h, u64 n, const char* s, u64 k, u64& scanned) noexcept
+        {
+            const __m128i first = _mm_set1_epi8(s[0]);
+            const __m128i last = _mm_set1_epi8(s[k - 1]);
+            u64 i = 0;
+            for (; i + k - 1 + 16 <= n; i += 16)
+            {
+                const __m128i bf = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i));
+                const __m128i bl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + k - 1));
+                u32 mask = static_cast<u32>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(bf, first), _mm_cmpeq_epi8(bl, last))));
+                for (; mask; mask &= mask - 1)
+                {
+                    const u64 p = i + __builtin_ctz(mask);
+                    if (!std::memcmp(h + p + 1, s + 1, k - 2))
+                        return p;
+                }
+            }
+            scanned = i;
+            return npos;
+        }
+
+        UF_TARGET("avx2") inline u64 find_filtered_avx2(const char* h, u64 n, const char* s, u64 k, u64& scanned) noexcept
+        {
+            const __m256i first = _mm256_set1_epi8(s[0]);
+            const __m256i last = _mm256_set1_epi8(s[k - 1]);
+            u64 i = 0;
+            for (; i + k - 1 + 32 <= n; i += 32)
+            {
+                const __m256i bf = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i));
+                const __m256i bl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i + k - 1));
+                u32 mask = static_cast<u32>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(bf, first), _mm256_cmpeq_epi8(bl, last))));
+                for (; mask; mask &= mask - 1)
+                {
+                    const u64 p = i + __builtin_ctz(mask);
+                    if (!std::memcmp(h + p + 1, s + 1, k - 2))
+                        return p;
+                }
+            }
+            scanned = i;
+            return npos;
+        }
+
+        UF_TARGET("avx512f,avx512bw") inline u64 find_filtered_avx512(const char* h, u64 n, const char* s, u64 k, u64& scanned) noexcept
+        {
+            const __m512i first = _mm512_set1_epi8(s[0]);
+            const __m512i last = _mm512_set1_epi8(s[k - 1]);
+            u64 i = 0;
+            for (; i + k - 1 + 64 <= n; i += 64)
+            {
+                const __m512i bf = _mm512_loadu_si512(h + i);
+                const __m512i bl = _mm512_loadu_si512(h + i + k - 1);
+                u64 mask = _mm512_cmpeq_epi8_mask(bf, first) & _mm512_cmpeq_epi8_mask(bl, last);
+                for (; mask; mask &= mask - 1)
+                {
+                    const u64 p = i + __builtin_ctzll(mask);
+                    if (!std::memcmp(h + p + 1, s + 1, k - 2))
+                        return p;
+                }
+            }
+            scanned = i;
+            return npos;
+        }
+#endif
+
+        inline u64 find_filtered(const char* h, u64 n, const char* s, u64 k) noexcept
+        {
+            u64 scanned = 0;
+#ifdef UF_SIMD_X86
+            u64 result = npos;
+            switch (simd::active())
+            {
+            case simd::level::avx512:
+                result = find_filtered_avx512(h, n, s, k, scanned);
+                break;
+            case simd::level::avx2:
+                result = find_filtered_avx2(h, n, s, k, scanned);
+                break;
+            case simd::level::sse2:
+                result = find_filtered_sse2(h, n, s, k, scanned);
+                break;
+            case simd::level::scalar:
+                break;
+            }
+            if (result != npos)
+                return result;
+#endif
+            return find_filtered_scalar(h, n, s, k, scanned);
+        }
+
+        // shift is only read for needles of at least horspool_threshold bytes
+        inline u64 find(std::string_view haystack, std::string_view needle, u64 pos, const horspool_table* shift) noexcept
+        {
+            const u64 n = haystack.size();
+            const u64 k = needle.size();
+            if (pos > n || k > n - pos)
+                return npos;
+            if (!k)
+                return pos;
+
+            const char* h = haystack.data() + pos;
+            u64 result;
+            if (k == 1)
+            {
+                const void* p = std::memchr(h, needle[0], n - pos);
+                return p ? static_cast<const char*>(p) - haystack.data() : npos;
+            }
+            if (k < horspool_threshold || simd::active() != simd::level::scalar)
+                result = find_filtered(h, n - pos, needle.data(), k);
+            else if (shift)
+                result = find_horspool(h, n - pos, needle.data(), k, *shift);
+            else
+            {
+                horspool_table table;
+                build_horspool_table(needle.data(), k, table);
+                result = find_horspool(h, n - pos, needle.data(), k, table);
+            }
+            return result == npos ? npos : result + pos;
+        }
+
+        // Calls f with the shift table find needs for needle: built once on the stack when Horspool runs, null
+        // otherwise, so one-shot searches never allocate
+        template<class F>
+        auto with_shift(std::string_view needle, F&& f)
+        {
+            if (needle.size() >= horspool_threshold && simd::active() == simd::level::scalar)
+            {
+                horspool_table table;
+                build_horspool_table(needle.data(), needle.size(), table);
+                return f(&table);
+            }
+            return f(static_cast<const horspool_table*>(nullptr));
+        }
+
+        // find(pos) is the first occurrence at or after pos of a needle of k bytes
+        template<class Find>
+        u64 count(std::string_view haystack, u64 k, const Find& find) noexcept
+        {
+            if (!k)
+                return 0;
+            u64 result = 0;
+            for (u64 p = find(0); p != npos; p = find(p + k))
+                ++result;
+            return result;
+        }
+
+        template<class Find>
+        std::string replace_all(std::string_view s, u64 k, std::string_view to, const Find& find)
+        {
+            if (!k)
+                return std::string(s);
+            std::string result;
+            result.reserve(s.size());
+            u64 done = 0;
+            for (u64 p = find(0); p != npos; p = find(done))
+            {
+                result.append(s.data() + done, p - done);
+                result.append(to);
+                done = p + k;
+            }
+            result.append(s.data() + done, s.size() - done);
+            return result;
+        }
+    }
+    // namespace detail
+
+    inline namespace search
+    {
+        // Needle compiled once for repeated searches, owns a copy of the needle
+        class searcher
+        {
+            std::string m_needle;
+            std::unique_ptr<detail::horspool_table> m_shift;
+
+        public:
+            explicit searcher(std::string_view needle) : m_needle(needle)
+            {
+                if (m_needle.size() >= detail::horspool_threshold)
+                {
+                    m_shift = std::make_unique<detail::horspool_table>();
+                    detail::build_horspool_table(m_needle.data(), m_needle.size(), *m_shift);
+                }
+            }
+
+            std::string_view needle() const noexcept
+            {
+                return m_needle;
+            }
+
+            // Position of the first occurrence at or after pos, std::string_view::npos if there is none
+            u64 find(std::string_view haystack, u64 pos = 0) const noexcept
+            {
+                return detail::find(haystack, m_needle, pos, m_shift.get());
+            }
+        };
+
+        inline u64 find(std::string_view haystack, std::string_view needle, u64 pos = 0) noexcept
+        {
+            return detail::find(haystack, needle, pos, nullptr);
+        }
+
+        inline u64 find(std::string_view haystack, const searcher& needle, u64 pos = 0) noexcept
+        {
+            return needle.find(haystack, pos);
+        }
+
+        template<typename Needle>
+        bool contains(std::string_view haystack, const Needle& needle) noexcept
+        {
+            return find(haystack, needle) != detail::npos;
+        }
+
+        // Non-overlapping occurrences. An empty needle has none, matching replace_all which leaves the text as is.
+        inline u64 count(std::string_view haystack, const searcher& needle) noexcept
+        {
+            return detail::count(haystack, needle.needle().size(), [&](u64 pos){ return needle.find(haystack, pos); });
+        }
+
+        inline u64 count(std::string_view haystack, std::string_view needle) noexcept
+        {
+            return detail::with_shift(needle, [&](const detail::horspool_table* shift)
+            {
+                return detail::count(haystack, needle.size(), [&](u64 pos){ return detail::find(haystack, needle, pos, shift); });
+            });
+        }
+
+        // Every non-overlapping occurrence of from replaced with to, left to right. An empty from replaces nothing.
+        inline std::string replace_all(std::string_view s, const searcher& from, std::string_view to)
+        {
+            return detail::replace_all(s, from.needle().size(), to, [&](u64 pos){ return from.find(s, pos); });
+        }
+
+        inline std::string replace_all(std::string_view s, std::string_view from, std::string_view to)
+        {
+            return detail::with_shift(from, [&](const detail::horspool_table* shift)
+            {
+                return detail::replace_all(s, from.size(), to, [&](u64 pos){ return detail::find(s, from, pos, shift); });
+            });
+        }
+    }
+    // inline namespace search
+}
+// namespace uf
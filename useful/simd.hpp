@@ -0,0 +1,361 @@
+#pragma once
+#include <atomic>
+#include <algorithm>
+
+#include "base.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define UF_SIMD_X86
+#define UF_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace uf::simd
+{
+    // Instruction set levels in increasing order, kernels are picked by the highest active one
+    enum class level : u8
+    {
+        scalar,
+        sse2,
+        avx2,
+        avx512
+    };
+
+    namespace detail
+    {
+        inline level detect_level() noexcept
+        {
+#ifdef UF_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+                return level::avx512;
+            if (__builtin_cpu_supports("avx2"))
+                return level::avx2;
+            if (__builtin_cpu_supports("sse2"))
+                return level::sse2;
+#endif
+            return level::scalar;
+        }
+
+        inline std::atomic<level>& active_level() noexcept
+        {
+            static std::atomic<level> result(detect_level());
+            return result;
+        }
+    }
+    // namespace detail
+
+    inline level supported() noexcept
+    {
+        static const level result = detail::detect_level();
+        return result;
+    }
+
+    inline level active() noexcept
+    {
+        return detail::active_level().load(std::memory_order_relaxed);
+    }
+
+    // Caps dispatch at the given level (never above what the CPU supports), useful for tests and benchmarks
+    inline void limit(level l) noexcept
+    {
+        detail::active_level().store(std::min(l, supported()), std::memory_order_relaxed);
+    }
+
+    // Set of byte values with lookup tables for the vector scanners below
+    class byte_set
+    {
+        static constexpr u32 max_compared = 8;
+
+        u64 m_bits[4]{};
+        char m_chars[max_compared]{};
+        u32 m_size = 0;
+        u8 m_low[16]{};
+        u8 m_high[16]{};
+
+    public:
+        constexpr byte_set() noexcept = default;
+
+        template<typename... Cs>
+        constexpr explicit byte_set(Cs... cs) noexcept
+        {
+            (insert(cs), ...);
+        }
+
+        constexpr void insert(char c) noexcept
+        {
+            const u8 b = static_cast<u8>(c);
+            if (contains(c))
+                return;
+            m_bits[b >> 6] |= u64(1) << (b & 63);
+            if (m_size < max_compared)
+                m_chars[m_size] = c;
+            ++m_size;
+            // Low nibble selects the table entry, high nibble selects the bit (truffle lookup)
+            if (b < 0x80)
+                m_low[b & 15] |= static_cast<u8>(1 << (b >> 4));
+            else
+                m_high[b & 15] |= static_cast<u8>(1 << ((b >> 4) - 8));
+        }
+
+        constexpr bool contains(char c) const noexcept
+        {
+            const u8 b = static_cast<u8>(c);
+            return m_bits[b >> 6] >> (b & 63) & 1;
+        }
+
+        constexpr u32 size() const noexcept
+        {
+            return m_size;
+        }
+
+        // Small sets are matched with one compare per member, larger ones through shuffle lookups
+        constexpr bool compared() const noexcept
+        {
+            return m_size <= max_compared;
+        }
+
+        constexpr const char* chars() const noexcept
+        {
+            return m_chars;
+        }
+
+        constexpr const u8* low_table() const noexcept
+        {
+            return m_low;
+        }
+
+        constexpr const u8* high_table() const noexcept
+        {
+            return m_high;
+        }
+    };
+
+    namespace detail
+    {
+        static constexpr u64 block_size = 64;
+        static constexpr u64 batch_blocks = 16;
+
+        inline u64 block_mask_scalar(const char* p, u64 count, const byte_set& set) noexcept
+        {
+            u64 result = 0;
+            for (u64 i = 0; i < count; ++i)
+                result |= u64(set.contains(p[i])) << i;
+            return result;
+        }
+
+        inline void block_masks_scalar(const char* p, u64 blocks, const byte_set& set, u64* out) noexcept
+        {
+            for (u64 b = 0; b < blocks; ++b)
+                out[b] = block_mask_scalar(p + b * block_size, block_size, set);
+        }
+
+#ifdef UF_SIMD_X86
+        UF_TARGET("sse2") inline void block_masks_sse2(const char* p, u64 blocks, const byte_set& set, u64* out) noexcept
+        {
+            if (!set.compared())
+                return block_masks_scalar(p, blocks, set, out);
+            __m128i members[8];
+            for (u32 i = 0; i < set.size(); ++i)
+                members[i] = _mm_set1_epi8(set.chars()[i]);
+            for (u64 b = 0; b < blocks; ++b, p += block_size)
+            {
+                u64 mask = 0;
+                for (u64 k = 0; k < 4; ++k)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k * 16));
+                    __m128i hits = _mm_setzero_si128();
+                    for (u32 i = 0; i < set.size(); ++i)
+                        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, members[i]));
+                    mask |= u64(static_cast<u32>(_mm_movemask_epi8(hits))) << (k * 16);
+                }
+                out[b] = mask;
+            }
+        }
+
+        UF_TARGET("avx2") inline void block_masks_avx2(const char* p, u64 blocks, const byte_set& set, u64* out) noexcept
+        {
+            const __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.low_table())));
+            const __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.high_table())));
+            const __m256i bit = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                                 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            const __m256i index = _mm256_set1_epi8(static_cast<char>(0x8f));
+            const __m256i sign = _mm256_set1_epi8(static_cast<char>(0x80));
+            const __m256i seven = _mm256_set1_epi8(7);
+            __m256i members[8];
+            for (u32 i = 0; i < set.size() && i < 8; ++i)
+                members[i] = _mm256_set1_epi8(set.chars()[i]);
+            for (u64 b = 0; b < blocks; ++b, p += block_size)
+            {
+                u64 mask = 0;
+                for (u64 k = 0; k < 2; ++k)
+                {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k * 32));
+                    __m256i hits;
+                    if (set.compared())
+                    {
+                        hits = _mm256_setzero_si256();
+                        for (u32 i = 0; i < set.size(); ++i)
+                            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(v, members[i]));
+                    }
+                    else
+                    {
+                        // Indices with the top bit set shuffle in zero, so each table only answers for its half
+                        const __m256i rows = _mm256_or_si256(_mm256_shuffle_epi8(low, _mm256_and_si256(v, index)),
+                                                             _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_xor_si256(v, sign), index)));
+                        const __m256i column = _mm256_shuffle_epi8(bit, _mm256_and_si256(_mm256_srli_epi16(v, 4), seven));
+                        hits = _mm256_cmpeq_epi8(_mm256_and_si256(rows, column), column);
+                    }
+                    mask |= u64(static_cast<u32>(_mm256_movemask_epi8(hits))) << (k * 32);
+                }
+                out[b] = mask;
+            }
+        }
+
+        // _mm512_broadcast_i32x4 reads an undefined vector that GCC 12 reports as uninitialized, the zero-masked
+        // form gives the same result without it
+        UF_TARGET("avx512f") inline __m512i broadcast_128(__m128i x) noexcept
+        {
+            return _mm512_maskz_broadcast_i32x4(static_cast<__mmask16>(~0u), x);
+        }
+
+        UF_TARGET("avx512f,avx512bw") inline void block_masks_avx512(const char* p, u64 blocks, const byte_set& set, u64* out) noexcept
+        {
+            const __m512i low = broadcast_128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.low_table())));
+            const __m512i high = broadcast_128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.high_table())));
+            const __m512i bit = broadcast_128(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128));
+            const __m512i index = _mm512_set1_epi8(static_cast<char>(0x8f));
+            const __m512i sign = _mm512_set1_epi8(static_cast<char>(0x80));
+            const __m512i seven = _mm512_set1_epi8(7);
+            __m512i members[8];
+            for (u32 i = 0; i < set.size() && i < 8; ++i)
+                members[i] = _mm512_set1_epi8(set.chars()[i]);
+            for (u64 b = 0; b < blocks; ++b, p += block_size)
+            {
+                const __m512i v = _mm512_loadu_si512(p);
+                __mmask64 mask = 0;
+                if (set.compared())
+                {
+                    for (u32 i = 0; i < set.size(); ++i)
+                        mask |= _mm512_cmpeq_epi8_mask(v, members[i]);
+                }
+                else
+                {
+                    const __m512i rows = _mm512_or_si512(_mm512_shuffle_epi8(low, _mm512_and_si512(v, index)),
+                                                         _mm512_shuffle_epi8(high, _mm512_and_si512(_mm512_xor_si512(v, sign), index)));
+                    const __m512i column = _mm512_shuffle_epi8(bit, _mm512_and_si512(_mm512_srli_epi16(v, 4), seven));
+                    mask = _mm512_test_epi8_mask(rows, column);
+                }
+                out[b] = mask;
+            }
+        }
+#endif
+
+        // Bit i of out[b] is set when p[b * 64 + i] belongs to the set
+        inline void block_masks(const char* p, u64 blocks, const byte_set& set, u64* out) noexcept
+        {
+#ifdef UF_SIMD_X86
+            switch (active())
+            {
+            case level::avx512:
+                return block_masks_avx512(p, blocks, set, out);
+            case level::avx2:
+                return block_masks_avx2(p, blocks, set, out);
+            case level::sse2:
+                return block_masks_sse2(p, blocks, set, out);
+            case level::scalar:
+                break;
+            }
+#endif
+            block_masks_scalar(p, blocks, set, out);
+        }
+    }
+    // namespace detail
+
+    // First byte in [first, last) outside of the set, last if there is none. The first byte is checked on its own
+    // because most inputs have no run to skip at all, after that the number of blocks per scan doubles, so short
+    // runs cost one block and long ones are scanned in full batches.
+    inline const char* skip_forward(const char* first, const char* last, const byte_set& set) noexcept
+    {
+        if (first == last || !set.contains(*first))
+            return first;
+        u64 masks[detail::batch_blocks];
+        for (u64 blocks = 1; static_cast<u64>(last - first) >= detail::block_size; blocks = std::min(blocks * 2, detail::batch_blocks))
+        {
+            blocks = std::min<u64>(blocks, (last - first) / detail::block_size);
+            detail::block_masks(first, blocks, set, masks);
+            for (u64 b = 0; b < blocks; ++b, first += detail::block_size)
+                if (~masks[b])
+                    return first + __builtin_ctzll(~masks[b]);
+        }
+        const u64 rest = last - first;
+        const u64 outside = ~detail::block_mask_scalar(first, rest, set) & ((u64(1) << rest) - 1);
+        return outside ? first + __builtin_ctzll(outside) : last;
+    }
+
+    // One past the last byte in [first, last) outside of the set, first if there is none
+    inline const char* skip_backward(const char* first, const char* last, const byte_set& set) noexcept
+    {
+        if (first == last || !set.contains(last[-1]))
+            return last;
+        u64 masks[detail::batch_blocks];
+        for (u64 blocks = 1; static_cast<u64>(last - first) >= detail::block_size; blocks = std::min(blocks * 2, detail::batch_blocks))
+        {
+            blocks = std::min<u64>(blocks, (last - first) / detail::block_size);
+            detail::block_masks(last - blocks * detail::block_size, blocks, set, masks);
+            for (u64 b = blocks; b--; last -= detail::block_size)
+                if (~masks[b])
+                    return last - __builtin_clzll(~masks[b]);
+        }
+        const u64 rest = last - first;
+        const u64 outside = ~detail::block_mask_scalar(first, rest, set) & ((u64(1) << rest) - 1);
+        return outside ? first + 64 - __builtin_clzll(outside) : first;
+    }
+
+    // Calls f(token_first, token_last) for at most n maximal runs of bytes outside of the set, in order
+    template<class F>
+    void for_each_token(const char* first, const char* last, const byte_set& delimiters, u64 n, F&& f)
+    {
+        if (!n)
+            return;
+        u64 masks[detail::batch_blocks];
+        u64 carry = 1;
+        const char* token = first;
+        for (const char* batch = first; batch != last;)
+        {
+            const u64 bytes = std::min<u64>(last - batch, detail::batch_blocks * detail::block_size);
+            const u64 full = bytes / detail::block_size;
+            detail::block_masks(batch, full, delimiters, masks);
+            u64 blocks = full;
+            if (const u64 rest = bytes % detail::block_size)
+            {
+                // Bytes past the end count as delimiters, which closes the last token
+                masks[blocks++] = detail::block_mask_scalar(batch + full * detail::block_size, rest, delimiters) | ~u64(0) << rest;
+            }
+            for (u64 b = 0; b < blocks; ++b)
+            {
+                const u64 delimiter = masks[b];
+                u64 edges = delimiter ^ (delimiter << 1 | carry);
+                carry = delimiter >> 63;
+                while (edges)
+                {
+                    const u64 i = __builtin_ctzll(edges);
+                    edges &= edges - 1;
+                    const char* p = batch + b * detail::block_size + i;
+                    if (!(delimiter >> i & 1))
+                        token = p;
+                    else
+                    {
+                        f(token, p);
+                        if (!--n)
+                            return;
+                    }
+                }
+            }
+            batch += bytes;
+        }
+        if (!carry)
+            f(token, last);
+    }
+}
+// namespace uf::simd
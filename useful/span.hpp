@@ -4,8 +4,27 @@
 
 namespace uf
 {
+    inline constexpr u64 dynamic_extent = std::numeric_limits<u64>::max();
+
+    // span<T> keeps its size at run time, span<T, N> has N in the type and stores only the pointer
+    template<typename Tp, u64 Extent = dynamic_extent>
+    class span;
+
+    namespace mt
+    {
+        template<typename Tp>
+        struct is_span : std::false_type { };
+
+        template<typename Tp, u64 Extent>
+        struct is_span<span<Tp, Extent>> : std::true_type { };
+
+        template<typename Tp>
+        inline constexpr bool is_span_v = is_span<Tp>::value;
+    }
+    // namespace mt
+
     template<typename Tp>
-    class span
+    class span<Tp, dynamic_extent>
     {
         static_assert(std::is_same_v<std::remove_volatile_t<std::remove_reference_t<Tp>>, Tp>, "Span must have a non-reference, non-volatile value_type");
 
@@ -20,6 +39,8 @@ namespace uf
         using reverse_iterator = std::reverse_iterator<iterator>;
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+        static constexpr u64 extent = dynamic_extent;
+
     private:
         pointer m_data = nullptr;
         u64 m_size = 0;
@@ -38,7 +59,7 @@ namespace uf
         template<class C>
         span(C&& c) : span(c.data(), c.size())
         {
-            static_assert (std::is_lvalue_reference_v<C> || mt::is_instantiated_from_v<uf::span, std::decay_t<C>>, "Attempt to create span from rvalue");
+            static_assert (std::is_lvalue_reference_v<C> || mt::is_span_v<std::decay_t<C>>, "Attempt to create span from rvalue");
         }
 
         template<u64 N>
@@ -68,6 +89,42 @@ namespace uf
             return span(m_data + bpos, count);
         }
 
+        // The first or last count elements, throws if there are fewer
+        constexpr span first(u64 count) const
+        {
+            if (count > m_size)
+                throw std::out_of_range("span::first: Count " + std::to_string(count) + " exceeds size " + std::to_string(m_size));
+            return span(m_data, count);
+        }
+
+        constexpr span last(u64 count) const
+        {
+            if (count > m_size)
+                throw std::out_of_range("span::last: Count " + std::to_string(count) + " exceeds size " + std::to_string(m_size));
+            return span(m_data + m_size - count, count);
+        }
+
+        // Static-extent views, the size is checked once here and never again by the result
+        template<u64 N>
+        constexpr span<Tp, N> first() const
+        {
+            return span<Tp, N>(first(N).data());
+        }
+
+        template<u64 N>
+        constexpr span<Tp, N> last() const
+        {
+            return span<Tp, N>(last(N).data());
+        }
+
+        template<u64 Offset, u64 N>
+        constexpr span<Tp, N> subspan() const
+        {
+            if (Offset > m_size || N > m_size - Offset)
+                throw std::out_of_range("span::subspan: [" + std::to_string(Offset) + ", " + std::to_string(Offset + N) + ") exceeds size " + std::to_string(m_size));
+            return span<Tp, N>(m_data + Offset);
+        }
+
         constexpr reference front() const
         {
             return m_data[0];
@@ -136,7 +193,179 @@ namespace uf
         }
     };
 
+    template<typename Tp, u64 Extent>
+    class span
+    {
+        static_assert(std::is_same_v<std::remove_volatile_t<std::remove_reference_t<Tp>>, Tp>, "Span must have a non-reference, non-volatile value_type");
+
+    public:
+        using value_type = Tp;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        static constexpr u64 extent = Extent;
+
+    private:
+        pointer m_data = nullptr;
+
+    public:
+        // begin must point to at least Extent elements
+        template<typename Up, typename = std::enable_if_t<std::is_convertible_v<Up(*)[], value_type(*)[]>>>
+        constexpr explicit span(Up* begin) noexcept : m_data(begin) { }
+
+        constexpr span(value_type(&arr)[Extent]) noexcept : m_data(arr) { }
+
+        template<typename Up, typename = std::enable_if_t<std::is_convertible_v<Up(*)[], value_type(*)[]>>>
+        constexpr span(std::array<Up, Extent>& arr) noexcept : m_data(arr.data()) { }
+
+        template<typename Up, typename = std::enable_if_t<std::is_convertible_v<const Up(*)[], value_type(*)[]>>>
+        constexpr span(const std::array<Up, Extent>& arr) noexcept : m_data(arr.data()) { }
+
+        template<typename Up, typename = std::enable_if_t<std::is_convertible_v<Up(*)[], value_type(*)[]>>>
+        constexpr span(const span<Up, Extent>& s) noexcept : m_data(s.data()) { }
+
+        // From a dynamic span of exactly Extent elements
+        template<typename Up, typename = std::enable_if_t<std::is_convertible_v<Up(*)[], value_type(*)[]>>>
+        constexpr explicit span(const span<Up>& s) : m_data(s.data())
+        {
+            if (s.size() != Extent)
+                throw std::out_of_range("span::span: Size " + std::to_string(s.size()) + " does not match extent " + std::to_string(Extent));
+        }
+
+        static constexpr u64 size() noexcept
+        {
+            return Extent;
+        }
+
+        static constexpr bool empty() noexcept
+        {
+            return !Extent;
+        }
+
+        template<u64 N>
+        constexpr span<Tp, N> first() const noexcept
+        {
+            static_assert (N <= Extent, "span::first: Count exceeds extent");
+            return span<Tp, N>(m_data);
+        }
+
+        template<u64 N>
+        constexpr span<Tp, N> last() const noexcept
+        {
+            static_assert (N <= Extent, "span::last: Count exceeds extent");
+            return span<Tp, N>(m_data + Extent - N);
+        }
+
+        // N defaults to the rest of the span
+        template<u64 Offset, u64 N = dynamic_extent>
+        constexpr auto subspan() const noexcept
+        {
+            static_assert (Offset <= Extent && (N == dynamic_extent || N <= Extent - Offset), "span::subspan: Range exceeds extent");
+            return span<Tp, N == dynamic_extent ? Extent - Offset : N>(m_data + Offset);
+        }
+
+        // Run-time sized parts are dynamic spans, clamped like span<T>::subspan
+        constexpr span<Tp> subspan(u64 begin, u64 count = std::numeric_limits<u64>::max()) const noexcept
+        {
+            return span<Tp>(m_data, Extent).subspan(begin, count);
+        }
+
+        constexpr reference front() const noexcept
+        {
+            static_assert (Extent, "span::front: Empty span");
+            return m_data[0];
+        }
+
+        constexpr reference back() const noexcept
+        {
+            static_assert (Extent, "span::back: Empty span");
+            return m_data[Extent - 1];
+        }
+
+        constexpr pointer data() const noexcept
+        {
+            return m_data;
+        }
+
+        constexpr reference operator[](u64 i) const
+        {
+            return m_data[i];
+        }
+
+        constexpr reference at(u64 i) const
+        {
+            if (i >= Extent)
+                throw std::out_of_range("span: Out of range, index = " + std::to_string(i) + ", but size = " + std::to_string(Extent));
+            return operator[](i);
+        }
+
+        constexpr iterator begin() const noexcept
+        {
+            return m_data;
+        }
+
+        constexpr iterator end() const noexcept
+        {
+            return m_data + Extent;
+        }
+
+        constexpr const_iterator cbegin() const noexcept
+        {
+            return m_data;
+        }
+
+        constexpr const_iterator cend() const noexcept
+        {
+            return m_data + Extent;
+        }
+
+        constexpr reverse_iterator rbegin() const noexcept
+        {
+            return reverse_iterator(m_data + Extent);
+        }
+
+        constexpr reverse_iterator rend() const noexcept
+        {
+            return reverse_iterator(m_data);
+        }
+
+        constexpr const_reverse_iterator crbegin() const noexcept
+        {
+            return reverse_iterator(m_data + Extent);
+        }
+
+        constexpr const_reverse_iterator crend() const noexcept
+        {
+            return reverse_iterator(m_data);
+        }
+    };
+
     template<typename C>
     span(C&& c) -> span<std::remove_pointer_t<decltype(c.data())>>;
+
+    // The object representation of the elements, a static extent stays static
+    template<typename Tp, u64 Extent>
+    span<const std::byte, Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(Tp)> as_bytes(span<Tp, Extent> s) noexcept
+    {
+        if constexpr (Extent == dynamic_extent)
+            return span<const std::byte>(reinterpret_cast<const std::byte*>(s.data()), s.size() * sizeof(Tp));
+        else
+            return span<const std::byte, Extent * sizeof(Tp)>(reinterpret_cast<const std::byte*>(s.data()));
+    }
+
+    template<typename Tp, u64 Extent, typename = std::enable_if_t<!std::is_const_v<Tp>>>
+    span<std::byte, Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(Tp)> as_writable_bytes(span<Tp, Extent> s) noexcept
+    {
+        if constexpr (Extent == dynamic_extent)
+            return span<std::byte>(reinterpret_cast<std::byte*>(s.data()), s.size() * sizeof(Tp));
+        else
+            return span<std::byte, Extent * sizeof(Tp)>(reinterpret_cast<std::byte*>(s.data()));
+    }
 }
 // namespace uf
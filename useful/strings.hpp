@@ -1,99 +1,519 @@
 #pragma once
 #include "utils.hpp"
+#include "span.hpp"
+#include "simd.hpp"
+#include "arena.hpp"
+#include "convert.hpp"
 
 namespace uf
 {
     namespace detail
     {
+        // Flips the case of every byte in [lo, lo + 25], 'A' gives lowercase and 'a' gives uppercase
+        inline void ascii_flip_case_scalar(const char* src, char* dst, u64 n, char lo) noexcept
+        {
+            for (u64 i = 0; i < n; ++i)
+                dst[i] = static_cast<u8>(src[i] - lo) < 26 ? src[i] ^ 0x20 : src[i];
+        }
+
+#ifdef UF_SIMD_X86
+        UF_TARGET("sse2") inline u64 ascii_flip_case_sse2(const char* src, char* dst, u64 n, char lo) noexcept
+        {
+            // Shift the range to [-128, -103] so that one signed compare selects it
+            const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80 - lo));
+            const __m128i bound = _mm_set1_epi8(-128 + 26);
+            const __m128i flip = _mm_set1_epi8(0x20);
+            u64 i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i mask = _mm_cmpgt_epi8(bound, _mm_add_epi8(v, bias));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(v, _mm_and_si128(mask, flip)));
+            }
+            return i;
+        }
+
+        UF_TARGET("avx2") inline u64 ascii_flip_case_avx2(const char* src, char* dst, u64 n, char lo) noexcept
+        {
+            const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80 - lo));
+            const __m256i bound = _mm256_set1_epi8(-128 + 26);
+            const __m256i flip = _mm256_set1_epi8(0x20);
+            u64 i = 0;
+            for (; i + 32 <= n; i += 32)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                const __m256i mask = _mm256_cmpgt_epi8(bound, _mm256_add_epi8(v, bias));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(v, _mm256_and_si256(mask, flip)));
+            }
+            return i;
+        }
+
+        UF_TARGET("avx512f,avx512bw") inline u64 ascii_flip_case_avx512(const char* src, char* dst, u64 n, char lo) noexcept
+        {
+            const __m512i low = _mm512_set1_epi8(lo);
+            const __m512i range = _mm512_set1_epi8(26);
+            const __m512i flip = _mm512_set1_epi8(0x20);
+            for (u64 i = 0; i < n; i += 64)
+            {
+                // Masked load and store handle the tail, so no scalar remainder is left
+                const __mmask64 active = n - i >= 64 ? ~__mmask64(0) : (__mmask64(1) << (n - i)) - 1;
+                const __m512i v = _mm512_maskz_loadu_epi8(active, src + i);
+                const __mmask64 letters = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(v, low), range);
+                _mm512_mask_storeu_epi8(dst + i, active, _mm512_mask_blend_epi8(letters, v, _mm512_xor_si512(v, flip)));
+            }
+            return n;
+        }
+#endif
+
+        inline void ascii_flip_case(const char* src, char* dst, u64 n, char lo) noexcept
+        {
+            u64 done = 0;
+#ifdef UF_SIMD_X86
+            switch (simd::active())
+            {
+            case simd::level::avx512:
+                done = ascii_flip_case_avx512(src, dst, n, lo);
+                break;
+            case simd::level::avx2:
+                done = ascii_flip_case_avx2(src, dst, n, lo);
+                break;
+            case simd::level::sse2:
+                done = ascii_flip_case_sse2(src, dst, n, lo);
+                break;
+            case simd::level::scalar:
+                break;
+            }
+#endif
+            ascii_flip_case_scalar(src + done, dst + done, n - done, lo);
+        }
+
+        // OR 0x20 maps an uppercase letter to its lowercase, only letters get it so '@' never matches '`'
+        inline char ascii_fold(char c) noexcept
+        {
+            return static_cast<u8>((c | 0x20) - 'a') < 26 ? c | 0x20 : c;
+        }
+
+        // ascii_fold of eight bytes at once. A byte is a letter when its low seven bits with 0x20 set land in
+        // ['a', 'z'] and its top bit is clear, the per-byte sums never carry into the next byte.
+        inline u64 ascii_fold_word(u64 x) noexcept
+        {
+            constexpr u64 ones = 0x0101010101010101;
+            const u64 t = (x | ones * 0x20) & ones * 0x7f;
+            const u64 above_a = t + ones * (0x80 - 'a');
+            const u64 above_z = t + ones * (0x80 - 'z' - 1);
+            const u64 letters = above_a & ~above_z & ~x & ones * 0x80;
+            return x | letters >> 2;
+        }
+
+        inline bool ascii_iequal_scalar(const char* a, const char* b, u64 n) noexcept
+        {
+            for (; n >= 8; a += 8, b += 8, n -= 8)
+            {
+                u64 wa, wb;
+                std::memcpy(&wa, a, 8);
+                std::memcpy(&wb, b, 8);
+                if (ascii_fold_word(wa) != ascii_fold_word(wb))
+                    return false;
+            }
+            for (u64 i = 0; i < n; ++i)
+                if (ascii_fold(a[i]) != ascii_fold(b[i]))
+                    return false;
+            return true;
+        }
+
+        // A lane matches when the bytes are equal, or equal after OR 0x20 and a letter. Returns how many bytes were
+        // compared (whole vectors only) or npos on a mismatch.
+#ifdef UF_SIMD_X86
+        UF_TARGET("sse2") inline u64 ascii_iequal_sse2(const char* a, const char* b, u64 n) noexcept
+        {
+            const __m128i flip = _mm_set1_epi8(0x20);
+            const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80 - 'a'));
+            const __m128i bound = _mm_set1_epi8(-128 + 26);
+            u64 i = 0;
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                const __m128i la = _mm_or_si128(va, flip);
+                const __m128i letter = _mm_cmpgt_epi8(bound, _mm_add_epi8(la, bias));
+                const __m128i ok = _mm_or_si128(_mm_cmpeq_epi8(va, vb), _mm_and_si128(letter, _mm_cmpeq_epi8(la, _mm_or_si128(vb, flip))));
+                if (_mm_movemask_epi8(ok) != 0xffff)
+                    return std::numeric_limits<u64>::max();
+            }
+            return i;
+        }
+
+        UF_TARGET("avx2") inline u64 ascii_iequal_avx2(const char* a, const char* b, u64 n) noexcept
+        {
+            const __m256i flip = _mm256_set1_epi8(0x20);
+            const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80 - 'a'));
+            const __m256i bound = _mm256_set1_epi8(-128 + 26);
+            u64 i = 0;
+            for (; i + 32 <= n; i += 32)
+            {
+                const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                const __m256i la = _mm256_or_si256(va, flip);
+                const __m256i letter = _mm256_cmpgt_epi8(bound, _mm256_add_epi8(la, bias));
+                const __m256i ok = _mm256_or_si256(_mm256_cmpeq_epi8(va, vb), _mm256_and_si256(letter, _mm256_cmpeq_epi8(la, _mm256_or_si256(vb, flip))));
+                if (static_cast<u32>(_mm256_movemask_epi8(ok)) != 0xffffffff)
+                    return std::numeric_limits<u64>::max();
+            }
+            return i;
+        }
+#endif
+
+        inline bool ascii_iequal(const char* a, const char* b, u64 n) noexcept
+        {
+            u64 done = 0;
+#ifdef UF_SIMD_X86
+            switch (simd::active())
+            {
+            case simd::level::avx512:
+            case simd::level::avx2:
+                done = ascii_iequal_avx2(a, b, n);
+                break;
+            case simd::level::sse2:
+                done = ascii_iequal_sse2(a, b, n);
+                break;
+            case simd::level::scalar:
+                break;
+            }
+            if (done == std::numeric_limits<u64>::max())
+                return false;
+#endif
+            return ascii_iequal_scalar(a + done, b + done, n - done);
+        }
+
+        inline u64 ascii_ifind_scalar(const char* h, u64 n, const char* s, u64 k, u64 from) noexcept
+        {
+            const char first = ascii_fold(s[0]);
+            const char last = ascii_fold(s[k - 1]);
+            for (u64 i = from; i + k <= n; ++i)
+                if (ascii_fold(h[i]) == first && ascii_fold(h[i + k - 1]) == last && ascii_iequal(h + i + 1, s + 1, k - 2))
+                    return i;
+            return std::numeric_limits<u64>::max();
+        }
+
+#ifdef UF_SIMD_X86
+        // Candidates are positions where the first and the last needle bytes match after folding, like the filter of
+        // find. A letter is compared with OR 0x20 applied to both sides, anything else exactly.
+        UF_TARGET("avx2") inline u64 ascii_ifind_avx2(const char* h, u64 n, const char* s, u64 k, u64& scanned) noexcept
+        {
+            const auto fold_mask = [](char c) { return static_cast<char>(static_cast<u8>((c | 0x20) - 'a') < 26 ? 0x20 : 0); };
+            const __m256i first_mask = _mm256_set1_epi8(fold_mask(s[0]));
+            const __m256i last_mask = _mm256_set1_epi8(fold_mask(s[k - 1]));
+            const __m256i first = _mm256_set1_epi8(static_cast<char>(s[0] | fold_mask(s[0])));
+            const __m256i last = _mm256_set1_epi8(static_cast<char>(s[k - 1] | fold_mask(s[k - 1])));
+            u64 i = 0;
+            for (; i + k - 1 + 32 <= n; i += 32)
+            {
+                const __m256i bf = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i)), first_mask);
+                const __m256i bl = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i + k - 1)), last_mask);
+                u32 mask = static_cast<u32>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(bf, first), _mm256_cmpeq_epi8(bl, last))));
+                for (; mask; mask &= mask - 1)
+                {
+                    const u64 p = i + __builtin_ctz(mask);
+                    if (ascii_iequal(h + p + 1, s + 1, k - 2))
+                        return p;
+                }
+            }
+            scanned = i;
+            return std::numeric_limits<u64>::max();
+        }
+#endif
+
+        inline u64 ascii_ifind(std::string_view haystack, std::string_view needle, u64 pos) noexcept
+        {
+            constexpr u64 npos = std::numeric_limits<u64>::max();
+            const u64 n = haystack.size();
+            const u64 k = needle.size();
+            if (pos > n || k > n - pos)
+                return npos;
+            if (!k)
+                return pos;
+            const char* h = haystack.data() + pos;
+            if (k == 1)
+            {
+                const char c = ascii_fold(needle[0]);
+                const char* found = std::find_if(h, haystack.data() + n, [c](char x) { return ascii_fold(x) == c; });
+                return found == haystack.data() + n ? npos : found - haystack.data();
+            }
+            u64 scanned = 0;
+#ifdef UF_SIMD_X86
+            if (simd::active() >= simd::level::avx2)
+            {
+                const u64 result = ascii_ifind_avx2(h, n - pos, needle.data(), k, scanned);
+                if (result != npos)
+                    return result + pos;
+            }
+#endif
+            const u64 result = ascii_ifind_scalar(h, n - pos, needle.data(), k, scanned);
+            return result == npos ? npos : result + pos;
+        }
+
+        template<class SeqContainer, typename = sfinae>
+        struct is_char_data : std::false_type { };
+
+        template<class SeqContainer>
+        struct is_char_data<SeqContainer, sfinae_t<decltype(std::declval<const SeqContainer&>().data())>>
+            : std::bool_constant<std::is_same_v<decltype(std::declval<const SeqContainer&>().data()), const char*>> { };
+
+        // Contiguous char data split by plain char delimiters goes through the vector scanner
+        template<class SeqContainer, typename... Ds>
+        inline constexpr bool is_char_split_v = sizeof...(Ds) && is_char_data<SeqContainer>::value && (std::is_same_v<std::decay_t<Ds>, char> && ...);
+
+        // Calls f(first, last) with the const iterators of at most n tokens, this is the scan behind every split function
+        template<class SeqContainer, class F, typename... Ds>
+        void split_for_each(const SeqContainer& c, u64 n, F&& f, Ds&&... ds)
+        {
+            using iter = typename SeqContainer::const_iterator;
+
+            if constexpr (is_char_split_v<SeqContainer, Ds...>)
+            {
+                const char* data = c.data();
+                simd::for_each_token(data, data + c.size(), simd::byte_set(ds...), n, [&](const char* first, const char* last)
+                {
+                    f(c.begin() + (first - data), c.begin() + (last - data));
+                });
+            }
+            else
+            {
+                auto&& fobject = stf_any_obj(std::forward<Ds>(ds)...);
+                const auto wrp = std::ref(fobject);
+                for (iter next_begin = std::find_if_not(c.begin(), c.end(), wrp); n && next_begin != c.end();)
+                {
+                    iter next_delimiter = std::find_if(std::next(next_begin), c.end(), wrp);
+                    f(next_begin, next_delimiter);
+                    if (next_delimiter == c.end())
+                        break;
+                    next_begin = std::find_if_not(std::next(next_delimiter), c.end(), wrp);
+                    --n;
+                }
+            }
+        }
+
+        // Below this many elements per thread parallel_split uses fewer threads
+        inline constexpr u64 parallel_split_min_chunk = 1 << 16;
+
+        template<typename Tp>
+        using token_view_t = std::conditional_t<std::is_same_v<std::remove_const_t<Tp>, char>, std::string_view, span<Tp>>;
+
+        template<class Container, typename View>
+        void emplace_token(Container& c, const View& v)
+        {
+            if constexpr (std::is_constructible_v<typename Container::value_type, const View&>)
+                c.emplace_back(v);
+            else
+                c.emplace_back(v.begin(), v.end());
+        }
+
+        template<class SeqContainer, class Out, class Store, typename... Ds>
+        auto split_into_impl(const SeqContainer& c, u64 n, Out&& out, Store&& store, Ds&&... ds)
+        {
+            using value_type = std::remove_pointer_t<decltype(c.data())>;
+            using view = token_view_t<value_type>;
+
+            const span<value_type> data(c.data(), c.size());
+            if constexpr (mt::is_iterator_v<std::decay_t<Out>>)
+            {
+                std::decay_t<Out> result = out;
+                split_for_each(data, n, [&](value_type* first, value_type* last){ *result++ = store(view(first, last - first)); }, std::forward<Ds>(ds)...);
+                return result;
+            }
+            else
+            {
+                out.clear();
+                split_for_each(data, n, [&](value_type* first, value_type* last){ emplace_token(out, store(view(first, last - first))); }, std::forward<Ds>(ds)...);
+            }
+        }
+
+        inline u64 decimal_length(u64 v) noexcept
+        {
+            static constexpr u64 powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+                                             10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000,
+                                             1000000000000000, 10000000000000000, 100000000000000000,
+                                             1000000000000000000, 10000000000000000000u};
+            // log10(2) ~ 1233 / 4096 gives the length up to one, the table settles it
+            const u64 guess = (64 - __builtin_clzll(v | 1)) * 1233 >> 12;
+            return guess + ((v | 1) >= powers[guess]);
+        }
+
+        // Text length and text of the parts accepted by concat and join: chars, anything convertible to
+        // std::string_view and numbers, which are written by to_chars
+        template<typename Tp>
+        u64 text_size(const Tp& part) noexcept
+        {
+            if constexpr (std::is_same_v<Tp, char>)
+                return 1;
+            else if constexpr (std::is_integral_v<Tp>)
+            {
+                static_assert (!std::is_same_v<Tp, bool>, "bool has no text form, convert it explicitly");
+                if constexpr (std::is_signed_v<Tp>)
+                    return (part < 0) + decimal_length(part < 0 ? 0 - static_cast<u64>(part) : static_cast<u64>(part));
+                else
+                    return decimal_length(part);
+            }
+            else if constexpr (std::is_floating_point_v<Tp>)
+            {
+                char buffer[64];
+                return format_to(buffer, part);
+            }
+            else
+                return std::string_view(part).size();
+        }
 
+        template<typename Tp>
+        char* write_text(char* out, const Tp& part) noexcept
+        {
+            if constexpr (std::is_same_v<Tp, char>)
+                *out++ = part;
+            else if constexpr (std::is_integral_v<Tp>)
+                out = std::to_chars(out, out + text_size(part), part).ptr;
+            else if constexpr (std::is_floating_point_v<Tp>)
+            {
+                char buffer[64];
+                const u64 n = format_to(buffer, part);
+                std::memcpy(out, buffer, n);
+                out += n;
+            }
+            else
+            {
+                const std::string_view view(part);
+                if (!view.empty())
+                    std::memcpy(out, view.data(), view.size());
+                out += view.size();
+            }
+            return out;
+        }
+        template<bool Left, bool Right, class SeqContainer, typename... Ps>
+        auto strip_view_impl(SeqContainer&& c, Ps&&... ps)
+        {
+            static_assert (std::is_lvalue_reference_v<SeqContainer> || mt::is_span_v<std::decay_t<SeqContainer>> || std::is_same_v<std::decay_t<SeqContainer>, std::string_view>,
+                           "Attempt to create strip view from rvalue");
+            using value_type = std::remove_pointer_t<decltype(c.data())>;
+            using view = token_view_t<value_type>;
+
+            value_type* first = c.data();
+            value_type* last = first + c.size();
+            if constexpr (is_char_split_v<std::decay_t<SeqContainer>, Ps...>)
+            {
+                const simd::byte_set set(ps...);
+                if constexpr (Left)
+                    first += simd::skip_forward(first, last, set) - first;
+                if constexpr (Right)
+                    last -= last - simd::skip_backward(first, last, set);
+            }
+            else
+            {
+                auto&& fobject = stf_any_obj(std::forward<Ps>(ps)...);
+                const auto wrp = std::ref(fobject);
+                if constexpr (Left)
+                    first = std::find_if_not(first, last, wrp);
+                if constexpr (Right)
+                    last = std::find_if_not(std::make_reverse_iterator(last), std::make_reverse_iterator(first), wrp).base();
+            }
+            return view(first, last - first);
+        }
     }
     // namespace detail
 
     inline namespace strings
     {
+        // ASCII only: bytes outside 'A'-'Z' / 'a'-'z' (including UTF-8 sequences) are left untouched
         inline std::string lowercase(const std::string& s)
         {
-            std::string result;
-            result.reserve(s.size());
-            for (auto c : s)
-                result.push_back(std::tolower(c));
+            std::string result(s.size(), '\0');
+            detail::ascii_flip_case(s.data(), result.data(), s.size(), 'A');
             return result;
         }
 
         inline std::string lowercase(std::string&& s)
         {
             std::string result(std::move(s));
-            for (auto& c : result)
-                c = std::tolower(c);
+            detail::ascii_flip_case(result.data(), result.data(), result.size(), 'A');
             return result;
         }
 
+        template<typename Tp, enif<std::is_same_v<Tp, char>> = SF>
+        void lowercase(span<Tp> s) noexcept
+        {
+            detail::ascii_flip_case(s.data(), s.data(), s.size(), 'A');
+        }
+
         inline std::string uppercase(const std::string& s)
         {
-            std::string result;
-            result.reserve(s.size());
-            for (auto c : s)
-                result.push_back(std::toupper(c));
+            std::string result(s.size(), '\0');
+            detail::ascii_flip_case(s.data(), result.data(), s.size(), 'a');
             return result;
         }
 
         inline std::string uppercase(std::string&& s)
         {
             std::string result(std::move(s));
-            for (auto& c : result)
-                c = std::toupper(c);
+            detail::ascii_flip_case(result.data(), result.data(), result.size(), 'a');
             return result;
         }
 
+        template<typename Tp, enif<std::is_same_v<Tp, char>> = SF>
+        void uppercase(span<Tp> s) noexcept
+        {
+            detail::ascii_flip_case(s.data(), s.data(), s.size(), 'a');
+        }
+
         template<class SeqContainer, typename... Ps>
         auto lstrip(const SeqContainer& c, Ps&&... ps)
         {
-            auto new_first = c.begin();
-            while (new_first != c.end() && stf_any(*new_first, ps...))
-                ++new_first;
+            auto new_first = std::find_if_not(c.begin(), c.end(), stf_any_obj(std::forward<Ps>(ps)...));
             return SeqContainer(new_first, c.end());
         }
 
         template<class SeqContainer, typename... Ps>
         auto rstrip(const SeqContainer& c, Ps&&... ps)
         {
-            auto new_last = c.rbegin();
-            while (new_last != c.rend() && stf_any(*new_last, ps...))
-                ++new_last;
+            auto new_last = std::find_if_not(c.rbegin(), c.rend(), stf_any_obj(std::forward<Ps>(ps)...));
             return SeqContainer(c.begin(), new_last.base());
         }
 
         template<class SeqContainer, typename... Ps>
         auto strip(const SeqContainer& c, Ps&&... ps)
         {
-            auto new_first = c.begin();
-            while (new_first != c.end() && stf_any(*new_first, ps...))
-                ++new_first;
-            auto new_last = c.rbegin();
-            while (new_last != c.rend() && stf_any(*new_last, ps...))
-                ++new_last;
+            auto&& fobject = stf_any_obj(std::forward<Ps>(ps)...);
+            const auto wrp = std::ref(fobject);
+            auto new_first = std::find_if_not(c.begin(), c.end(), wrp);
+            auto new_last = std::find_if_not(c.rbegin(), c.rend(), wrp);
             if (new_last.base() <= new_first)
                 return SeqContainer{ };
             return SeqContainer(new_first, new_last.base());
         }
 
+        // The *_view forms return a view into c instead of a copy. Plain char predicates over char data skip whole
+        // blocks of bytes with the vector scanner.
+        template<class SeqContainer, typename... Ps>
+        auto lstrip_view(SeqContainer&& c, Ps&&... ps)
+        {
+            return detail::strip_view_impl<true, false>(std::forward<SeqContainer>(c), std::forward<Ps>(ps)...);
+        }
+
+        template<class SeqContainer, typename... Ps>
+        auto rstrip_view(SeqContainer&& c, Ps&&... ps)
+        {
+            return detail::strip_view_impl<false, true>(std::forward<SeqContainer>(c), std::forward<Ps>(ps)...);
+        }
+
+        template<class SeqContainer, typename... Ps>
+        auto strip_view(SeqContainer&& c, Ps&&... ps)
+        {
+            return detail::strip_view_impl<true, true>(std::forward<SeqContainer>(c), std::forward<Ps>(ps)...);
+        }
+
         template<class SeqContainer, typename... Ds>
         auto split_itr_n(const SeqContainer& c, u64 n, Ds&&... ds)
         {
             using iter = typename SeqContainer::const_iterator;
 
             std::vector<std::pair<iter, iter>> result;
-            auto&& fobject = stf_any_obj(std::forward<Ds>(ds)...);
-            const auto wrp = std::ref(fobject);
-            for (iter next_begin = std::find_if_not(c.begin(), c.end(), wrp); n && next_begin != c.end();)
-            {
-                iter next_delimiter = std::find_if(std::next(next_begin), c.end(), wrp);
-                result.push_back({next_begin, next_delimiter});
-                if (next_delimiter == c.end())
-                    break;
-                next_begin = std::find_if_not(std::next(next_delimiter), c.end(), wrp);
-                --n;
-            }
+            detail::split_for_each(c, n, [&result](iter first, iter last){ result.push_back({first, last}); }, std::forward<Ds>(ds)...);
             return result;
         }
 
@@ -125,6 +545,207 @@ namespace uf
             return split_n(c, std::numeric_limits<u64>::max(), ds...);
         }
 
+        // Tokens of split_itr(c, ds...) for contiguous c, found by up to threads threads (0 means one per core). The
+        // input is cut into equal chunks and every cut moves forward to the next delimiter, so no token straddles
+        // two chunks and each chunk splits exactly as its part of the serial scan would. Returns the bounds of each
+        // chunk in order.
+        template<class SeqContainer, typename... Ds>
+        auto parallel_split_chunks(const SeqContainer& c, u32 threads, Ds&&... ds)
+        {
+            using iter = typename SeqContainer::const_iterator;
+            using value_type = std::remove_pointer_t<decltype(c.data())>;
+            using view = span<const std::remove_const_t<value_type>>;
+
+            const u64 size = c.size();
+            const auto data = c.data();
+            if (!threads)
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            threads = static_cast<u32>(std::clamp<u64>(size / detail::parallel_split_min_chunk, 1, threads));
+
+            std::vector<u64> cuts(threads + 1, size);
+            cuts[0] = 0;
+            auto&& fobject = stf_any_obj(ds...);
+            for (u32 k = 1; k < threads; ++k)
+            {
+                const u64 at = std::max(cuts[k - 1], size / threads * k);
+                cuts[k] = std::find_if(data + at, data + size, std::ref(fobject)) - data;
+            }
+
+            std::vector<std::vector<std::pair<iter, iter>>> result(threads);
+            const auto split_chunk = [&](u32 k)
+            {
+                auto& out = result[k];
+                const view chunk(data + cuts[k], cuts[k + 1] - cuts[k]);
+                detail::split_for_each(chunk, std::numeric_limits<u64>::max(), [&](const auto* first, const auto* last)
+                {
+                    out.emplace_back(c.begin() + (first - data), c.begin() + (last - data));
+                }, ds...);
+            };
+            std::vector<std::future<void>> pending;
+            for (u32 k = 1; k < threads; ++k)
+                pending.push_back(std::async(std::launch::async, split_chunk, k));
+            split_chunk(0);
+            for (auto& p : pending)
+                p.get();
+            return result;
+        }
+
+        // Same tokens as split_itr(c, ds...) in one vector, the chunks are joined by the same threads
+        template<class SeqContainer, typename... Ds>
+        auto parallel_split(const SeqContainer& c, u32 threads, Ds&&... ds)
+        {
+            auto chunks = parallel_split_chunks(c, threads, ds...);
+            std::vector<u64> offsets(chunks.size() + 1, 0);
+            for (u64 k = 0; k < chunks.size(); ++k)
+                offsets[k + 1] = offsets[k] + chunks[k].size();
+            if (chunks.size() == 1)
+                return std::move(chunks[0]);
+
+            std::vector<typename decltype(chunks)::value_type::value_type> result(offsets.back());
+            const auto join_chunk = [&](u64 k) { std::copy(chunks[k].begin(), chunks[k].end(), result.begin() + offsets[k]); };
+            std::vector<std::future<void>> pending;
+            for (u64 k = 1; k < chunks.size(); ++k)
+                pending.push_back(std::async(std::launch::async, join_chunk, k));
+            join_chunk(0);
+            for (auto& p : pending)
+                p.get();
+            return result;
+        }
+
+        // Writes token views to an output iterator (returned past the last token) or into a cleared sequence container
+        template<class SeqContainer, class Out, typename... Ds>
+        auto split_into_n(const SeqContainer& c, u64 n, Out&& out, Ds&&... ds)
+        {
+            return detail::split_into_impl(c, n, std::forward<Out>(out), [](const auto& v){ return v; }, std::forward<Ds>(ds)...);
+        }
+
+        // Same, but token bytes are copied into the arena first, so the views outlive the source
+        template<class SeqContainer, class Out, typename... Ds>
+        auto split_into_n(const SeqContainer& c, u64 n, Out&& out, monotonic_arena& arena, Ds&&... ds)
+        {
+            return detail::split_into_impl(c, n, std::forward<Out>(out), [&arena](const auto& v){ return arena.store(v); }, std::forward<Ds>(ds)...);
+        }
+
+        template<class SeqContainer, class Out, typename... Ds>
+        auto split_into(const SeqContainer& c, Out&& out, Ds&&... ds)
+        {
+            return split_into_n(c, std::numeric_limits<u64>::max(), std::forward<Out>(out), std::forward<Ds>(ds)...);
+        }
+
+        // Lazy counterpart of split_itr_n over a contiguous range, tokens are views into the original data
+        template<typename Tp, class F>
+        class split_range
+        {
+        public:
+            using value_type = detail::token_view_t<Tp>;
+
+            class iterator
+            {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = typename split_range::value_type;
+                using difference_type = i64;
+                using pointer = const value_type*;
+                using reference = value_type;
+
+            private:
+                const split_range* m_range = nullptr;
+                Tp* m_begin = nullptr;
+                Tp* m_end = nullptr;
+                u64 m_left = 0;
+
+                void settle(Tp* from)
+                {
+                    const auto wrp = std::ref(m_range->m_delimiter);
+                    m_begin = std::find_if_not(from, m_range->m_last, wrp);
+                    if (!m_left || m_begin == m_range->m_last)
+                        m_begin = m_end = m_range->m_last;
+                    else
+                        m_end = std::find_if(std::next(m_begin), m_range->m_last, wrp);
+                }
+
+            public:
+                iterator() = default;
+
+                iterator(const split_range* range, Tp* from, u64 n) : m_range(range), m_left(n)
+                {
+                    if (from == range->m_last)
+                        m_begin = m_end = from;
+                    else
+                        settle(from);
+                }
+
+                reference operator*() const
+                {
+                    return value_type(m_begin, m_end - m_begin);
+                }
+
+                iterator& operator++()
+                {
+                    if (m_end == m_range->m_last)
+                    {
+                        m_begin = m_end;
+                        return *this;
+                    }
+                    --m_left;
+                    settle(std::next(m_end));
+                    return *this;
+                }
+
+                iterator operator++(int)
+                {
+                    iterator result = *this;
+                    ++*this;
+                    return result;
+                }
+
+                bool operator==(const iterator& other) const noexcept
+                {
+                    return m_begin == other.m_begin;
+                }
+
+                bool operator!=(const iterator& other) const noexcept
+                {
+                    return m_begin != other.m_begin;
+                }
+            };
+
+        private:
+            Tp* m_first;
+            Tp* m_last;
+            u64 m_n;
+            mutable F m_delimiter;
+
+        public:
+            split_range(Tp* first, Tp* last, u64 n, F delimiter) : m_first(first), m_last(last), m_n(n), m_delimiter(std::move(delimiter)) { }
+
+            iterator begin() const
+            {
+                return iterator(this, m_first, m_n);
+            }
+
+            iterator end() const
+            {
+                return iterator(this, m_last, 0);
+            }
+        };
+
+        template<class SeqContainer, typename... Ds>
+        auto split_view_n(SeqContainer&& c, u64 n, Ds&&... ds)
+        {
+            static_assert (std::is_lvalue_reference_v<SeqContainer> || mt::is_span_v<std::decay_t<SeqContainer>> || std::is_same_v<std::decay_t<SeqContainer>, std::string_view>,
+                           "Attempt to create split view from rvalue");
+            using value_type = std::remove_pointer_t<decltype(c.data())>;
+            auto fobject = stf_any_obj(std::forward<Ds>(ds)...);
+            return split_range<value_type, decltype(fobject)>(c.data(), c.data() + c.size(), n, std::move(fobject));
+        }
+
+        template<class SeqContainer, typename... Ds>
+        auto split_view(SeqContainer&& c, Ds&&... ds)
+        {
+            return split_view_n(std::forward<SeqContainer>(c), std::numeric_limits<u64>::max(), std::forward<Ds>(ds)...);
+        }
+
         template<class C1, class C2, disif<std::is_convertible_v<C2, typename C1::value_type>> = SF>
         bool starts_with(const C1& c, const C2& pattern)
         {
@@ -170,6 +791,115 @@ namespace uf
         {
             return ends_with(c, std::string_view(literal, N - 1));
         }
+
+        // ASCII case-insensitive forms of equality, starts_with, ends_with and find. Bytes outside the ASCII letters
+        // compare exactly, nothing is copied or lowercased.
+        template<class C1, class C2>
+        bool iequals(const C1& a, const C2& b) noexcept
+        {
+            const std::string_view sa = detail::token_chars(a), sb = detail::token_chars(b);
+            return sa.size() == sb.size() && detail::ascii_iequal(sa.data(), sb.data(), sa.size());
+        }
+
+        template<class C, u64 N>
+        bool iequals(const C& c, const char(&literal)[N]) noexcept
+        {
+            return iequals(c, std::string_view(literal, N - 1));
+        }
+
+        template<class C1, class C2, disif<std::is_convertible_v<C2, typename C1::value_type>> = SF>
+        bool istarts_with(const C1& c, const C2& pattern) noexcept
+        {
+            const std::string_view s = detail::token_chars(c), p = detail::token_chars(pattern);
+            return p.size() <= s.size() && detail::ascii_iequal(s.data(), p.data(), p.size());
+        }
+
+        template<class C, class E, enif<std::is_convertible_v<E, typename C::value_type>> = SF>
+        bool istarts_with(const C& c, const E& e) noexcept
+        {
+            return !c.empty() && detail::ascii_fold(*std::begin(c)) == detail::ascii_fold(e);
+        }
+
+        template<class C1, class C2, disif<std::is_convertible_v<C2, typename C1::value_type>> = SF>
+        bool iends_with(const C1& c, const C2& pattern) noexcept
+        {
+            const std::string_view s = detail::token_chars(c), p = detail::token_chars(pattern);
+            return p.size() <= s.size() && detail::ascii_iequal(s.data() + s.size() - p.size(), p.data(), p.size());
+        }
+
+        template<class C, class E, enif<std::is_convertible_v<E, typename C::value_type>> = SF>
+        bool iends_with(const C& c, const E& e) noexcept
+        {
+            return !c.empty() && detail::ascii_fold(*std::rbegin(c)) == detail::ascii_fold(e);
+        }
+
+        template<class C, u64 N>
+        bool istarts_with(const C& c, const char(&literal)[N]) noexcept
+        {
+            return istarts_with(c, std::string_view(literal, N - 1));
+        }
+
+        template<class C, u64 N>
+        bool iends_with(const C& c, const char(&literal)[N]) noexcept
+        {
+            return iends_with(c, std::string_view(literal, N - 1));
+        }
+
+        // Position of the first case-insensitive occurrence at or after pos, std::string_view::npos if there is none
+        inline u64 ifind(std::string_view haystack, std::string_view needle, u64 pos = 0) noexcept
+        {
+            return detail::ascii_ifind(haystack, needle, pos);
+        }
+
+        // Appends every part to s with one size computation and at most one reallocation, returns s. Parts must not
+        // refer into s itself: the resize may move its text before the parts are copied.
+        template<typename... Parts>
+        std::string& append_to(std::string& s, const Parts&... parts)
+        {
+            if constexpr (sizeof...(Parts) > 0)
+            {
+                const u64 old = s.size();
+                s.resize(old + (detail::text_size(parts) + ...));
+                char* out = s.data() + old;
+                ((out = detail::write_text(out, parts)), ...);
+            }
+            return s;
+        }
+
+        // Parts are chars, strings, string views and numbers, the result is allocated once
+        template<typename... Parts>
+        std::string concat(const Parts&... parts)
+        {
+            std::string result;
+            append_to(result, parts...);
+            return result;
+        }
+
+        // Elements of the range separated by sep, both may be any part accepted by concat
+        template<class Range, typename Sep>
+        std::string join(const Range& range, const Sep& sep)
+        {
+            u64 size = 0;
+            u64 count = 0;
+            for (const auto& e : range)
+            {
+                size += detail::text_size(e);
+                ++count;
+            }
+            if (!count)
+                return std::string();
+            std::string result(size + (count - 1) * detail::text_size(sep), '\0');
+            char* out = result.data();
+            bool first = true;
+            for (const auto& e : range)
+            {
+                if (!first)
+                    out = detail::write_text(out, sep);
+                out = detail::write_text(out, e);
+                first = false;
+            }
+            return result;
+        }
     }
     // inline namespace strings
 }
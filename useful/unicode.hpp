@@ -0,0 +1,351 @@
+#pragma once
+#include "strings.hpp"
+
+namespace uf
+{
+    namespace detail
+    {
+        // Decodes one code point, returns its length in bytes or 0 for an invalid, overlong, surrogate or truncated
+        // sequence
+        inline u64 utf8_decode(const char* s, u64 n, u32& cp) noexcept
+        {
+            const u8 b0 = static_cast<u8>(s[0]);
+            if (b0 < 0x80)
+            {
+                cp = b0;
+                return 1;
+            }
+            const u64 length = b0 >= 0xf0 ? 4 : b0 >= 0xe0 ? 3 : b0 >= 0xc0 ? 2 : 0;
+            if (!length || length > n || b0 > 0xf4)
+                return 0;
+            u32 result = b0 & (0x7f >> length);
+            for (u64 i = 1; i < length; ++i)
+            {
+                const u8 b = static_cast<u8>(s[i]);
+                if ((b & 0xc0) != 0x80)
+                    return 0;
+                result = result << 6 | (b & 0x3f);
+            }
+            static constexpr u32 min_value[] = {0, 0, 0x80, 0x800, 0x10000};
+            if (result < min_value[length] || result > 0x10ffff || (result >= 0xd800 && result < 0xe000))
+                return 0;
+            cp = result;
+            return length;
+        }
+
+        inline u64 utf8_encode(u32 cp, char* out) noexcept
+        {
+            if (cp < 0x80)
+            {
+                out[0] = static_cast<char>(cp);
+                return 1;
+            }
+            if (cp < 0x800)
+            {
+                out[0] = static_cast<char>(0xc0 | cp >> 6);
+                out[1] = static_cast<char>(0x80 | (cp & 0x3f));
+                return 2;
+            }
+            if (cp < 0x10000)
+            {
+                out[0] = static_cast<char>(0xe0 | cp >> 12);
+                out[1] = static_cast<char>(0x80 | (cp >> 6 & 0x3f));
+                out[2] = static_cast<char>(0x80 | (cp & 0x3f));
+                return 3;
+            }
+            out[0] = static_cast<char>(0xf0 | cp >> 18);
+            out[1] = static_cast<char>(0x80 | (cp >> 12 & 0x3f));
+            out[2] = static_cast<char>(0x80 | (cp >> 6 & 0x3f));
+            out[3] = static_cast<char>(0x80 | (cp & 0x3f));
+            return 4;
+        }
+
+        // Length of the leading run of ASCII bytes, whole words at a time
+        inline u64 ascii_prefix_scalar(const char* s, u64 n) noexcept
+        {
+            u64 i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                u64 word;
+                std::memcpy(&word, s + i, 8);
+                if (const u64 high = word & 0x8080808080808080)
+                    return i + __builtin_ctzll(high) / 8;
+            }
+            while (i < n && static_cast<u8>(s[i]) < 0x80)
+                ++i;
+            return i;
+        }
+
+        inline bool utf8_validate_scalar(const char* s, u64 n) noexcept
+        {
+            for (u64 i = 0; i < n;)
+            {
+                i += ascii_prefix_scalar(s + i, n - i);
+                if (i == n)
+                    break;
+                u32 cp;
+                const u64 length = utf8_decode(s + i, n - i, cp);
+                if (!length)
+                    return false;
+                i += length;
+            }
+            return true;
+        }
+
+#ifdef UF_SIMD_X86
+        UF_TARGET("avx2") inline u64 ascii_prefix_avx2(const char* s, u64 n) noexcept
+        {
+            u64 i = 0;
+            for (; i + 32 <= n; i += 32)
+                if (const u32 high = static_cast<u32>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)))))
+                    return i + __builtin_ctz(high);
+            return i + ascii_prefix_scalar(s + i, n - i);
+        }
+
+        // Lookup validation of Keiser and Lemire: three nibble tables classify every pair of adjacent bytes into
+        // error bits, the pair is valid when no bit survives the and of all three. Bytes that must be the second or
+        // third continuation of a longer sequence are checked separately from the bytes two and three back.
+        UF_TARGET("avx2") inline void utf8_check_block_avx2(__m256i input, __m256i& error, __m256i& previous, __m256i& incomplete) noexcept
+        {
+            constexpr char too_short = 1 << 0;
+            constexpr char too_long = 1 << 1;
+            constexpr char overlong_3 = 1 << 2;
+            constexpr char too_large = 1 << 3;
+            constexpr char surrogate = 1 << 4;
+            constexpr char overlong_2 = 1 << 5;
+            constexpr char too_large_1000 = 1 << 6;
+            constexpr char overlong_4 = 1 << 6;
+            constexpr char two_conts = static_cast<char>(1 << 7);
+            constexpr char carry = too_short | too_long | two_conts;
+
+            if (!_mm256_movemask_epi8(input))
+            {
+                error = _mm256_or_si256(error, incomplete);
+                previous = input;
+                return;
+            }
+            const __m256i low_nibble = _mm256_set1_epi8(0x0f);
+            const __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21);
+            const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+            const __m256i byte_1_high = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_setr_epi8(
+                too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+                two_conts, two_conts, two_conts, two_conts,
+                too_short | overlong_2,
+                too_short,
+                too_short | overlong_3 | surrogate,
+                too_short | too_large | too_large_1000 | overlong_4)),
+                _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+            const __m256i byte_1_low = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_setr_epi8(
+                carry | overlong_3 | overlong_2 | overlong_4,
+                carry | overlong_2,
+                carry,
+                carry,
+                carry | too_large,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000 | surrogate,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000)),
+                _mm256_and_si256(prev1, low_nibble));
+            const __m256i byte_2_high = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_setr_epi8(
+                too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+                too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+                too_long | overlong_2 | two_conts | overlong_3 | too_large,
+                too_long | overlong_2 | two_conts | surrogate | too_large,
+                too_long | overlong_2 | two_conts | surrogate | too_large,
+                too_short, too_short, too_short, too_short)),
+                _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+            const __m256i special = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+            // Only 111_____ two back and 1111____ three back saturate to at least 0x80
+            const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+            const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+            const __m256i must_continue = _mm256_and_si256(_mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(0xe0 - 0x80)),
+                                                                           _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)))),
+                                                           _mm256_set1_epi8(static_cast<char>(0x80)));
+            error = _mm256_or_si256(error, _mm256_xor_si256(must_continue, special));
+
+            // Lead bytes too close to the end of the block to be complete within it
+            incomplete = _mm256_subs_epu8(input, _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                                  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                                  static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1), static_cast<char>(0xc0 - 1)));
+            previous = input;
+        }
+
+        UF_TARGET("avx2") inline bool utf8_validate_avx2(const char* s, u64 n) noexcept
+        {
+            __m256i error = _mm256_setzero_si256();
+            __m256i previous = _mm256_setzero_si256();
+            __m256i incomplete = _mm256_setzero_si256();
+            u64 i = 0;
+            for (; i + 32 <= n; i += 32)
+                utf8_check_block_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)), error, previous, incomplete);
+            // The tail is padded with zeros, which are ASCII and so also end any sequence cut by the end of the input
+            alignas(32) char tail[32] = {};
+            if (n > i)
+                std::memcpy(tail, s + i, n - i);
+            utf8_check_block_avx2(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)), error, previous, incomplete);
+            error = _mm256_or_si256(error, incomplete);
+            return _mm256_testz_si256(error, error);
+        }
+#endif
+
+        inline u64 ascii_prefix(const char* s, u64 n) noexcept
+        {
+#ifdef UF_SIMD_X86
+            if (simd::active() >= simd::level::avx2)
+                return ascii_prefix_avx2(s, n);
+#endif
+            return ascii_prefix_scalar(s, n);
+        }
+
+        // Simple case folding as runs of code points, each run maps first + k * stride to itself plus delta for
+        // k < count. Generated from the Unicode 14.0 CaseFolding.txt entries with status C and S.
+        struct fold_range
+        {
+            u32 first;
+            u16 count;
+            u8 stride;
+            i32 delta;
+        };
+
+        inline constexpr fold_range fold_ranges[] = {
+            {0x00041, 26, 1, 32}, {0x000B5, 1, 1, 775}, {0x000C0, 23, 1, 32}, {0x000D8, 7, 1, 32},
+            {0x00100, 24, 2, 1}, {0x00132, 3, 2, 1}, {0x00139, 8, 2, 1}, {0x0014A, 23, 2, 1}, {0x00178, 1, 1, -121},
+            {0x00179, 3, 2, 1}, {0x0017F, 1, 1, -268}, {0x00181, 1, 1, 210}, {0x00182, 2, 2, 1}, {0x00186, 1, 1, 206},
+            {0x00187, 1, 1, 1}, {0x00189, 2, 1, 205}, {0x0018B, 1, 1, 1}, {0x0018E, 1, 1, 79}, {0x0018F, 1, 1, 202},
+            {0x00190, 1, 1, 203}, {0x00191, 1, 1, 1}, {0x00193, 1, 1, 205}, {0x00194, 1, 1, 207},
+            {0x00196, 1, 1, 211}, {0x00197, 1, 1, 209}, {0x00198, 1, 1, 1}, {0x0019C, 1, 1, 211},
+            {0x0019D, 1, 1, 213}, {0x0019F, 1, 1, 214}, {0x001A0, 3, 2, 1}, {0x001A6, 1, 1, 218}, {0x001A7, 1, 1, 1},
+            {0x001A9, 1, 1, 218}, {0x001AC, 1, 1, 1}, {0x001AE, 1, 1, 218}, {0x001AF, 1, 1, 1}, {0x001B1, 2, 1, 217},
+            {0x001B3, 2, 2, 1}, {0x001B7, 1, 1, 219}, {0x001B8, 1, 1, 1}, {0x001BC, 1, 1, 1}, {0x001C4, 1, 1, 2},
+            {0x001C5, 1, 1, 1}, {0x001C7, 1, 1, 2}, {0x001C8, 1, 1, 1}, {0x001CA, 1, 1, 2}, {0x001CB, 9, 2, 1},
+            {0x001DE, 9, 2, 1}, {0x001F1, 1, 1, 2}, {0x001F2, 2, 2, 1}, {0x001F6, 1, 1, -97}, {0x001F7, 1, 1, -56},
+            {0x001F8, 20, 2, 1}, {0x00220, 1, 1, -130}, {0x00222, 9, 2, 1}, {0x0023A, 1, 1, 10795},
+            {0x0023B, 1, 1, 1}, {0x0023D, 1, 1, -163}, {0x0023E, 1, 1, 10792}, {0x00241, 1, 1, 1},
+            {0x00243, 1, 1, -195}, {0x00244, 1, 1, 69}, {0x00245, 1, 1, 71}, {0x00246, 5, 2, 1}, {0x00345, 1, 1, 116},
+            {0x00370, 2, 2, 1}, {0x00376, 1, 1, 1}, {0x0037F, 1, 1, 116}, {0x00386, 1, 1, 38}, {0x00388, 3, 1, 37},
+            {0x0038C, 1, 1, 64}, {0x0038E, 2, 1, 63}, {0x00391, 17, 1, 32}, {0x003A3, 9, 1, 32}, {0x003C2, 1, 1, 1},
+            {0x003CF, 1, 1, 8}, {0x003D0, 1, 1, -30}, {0x003D1, 1, 1, -25}, {0x003D5, 1, 1, -15},
+            {0x003D6, 1, 1, -22}, {0x003D8, 12, 2, 1}, {0x003F0, 1, 1, -54}, {0x003F1, 1, 1, -48},
+            {0x003F4, 1, 1, -60}, {0x003F5, 1, 1, -64}, {0x003F7, 1, 1, 1}, {0x003F9, 1, 1, -7}, {0x003FA, 1, 1, 1},
+            {0x003FD, 3, 1, -130}, {0x00400, 16, 1, 80}, {0x00410, 32, 1, 32}, {0x00460, 17, 2, 1},
+            {0x0048A, 27, 2, 1}, {0x004C0, 1, 1, 15}, {0x004C1, 7, 2, 1}, {0x004D0, 48, 2, 1}, {0x00531, 38, 1, 48},
+            {0x010A0, 38, 1, 7264}, {0x010C7, 1, 1, 7264}, {0x010CD, 1, 1, 7264}, {0x013F8, 6, 1, -8},
+            {0x01C80, 1, 1, -6222}, {0x01C81, 1, 1, -6221}, {0x01C82, 1, 1, -6212}, {0x01C83, 2, 1, -6210},
+            {0x01C85, 1, 1, -6211}, {0x01C86, 1, 1, -6204}, {0x01C87, 1, 1, -6180}, {0x01C88, 1, 1, 35267},
+            {0x01C90, 43, 1, -3008}, {0x01CBD, 3, 1, -3008}, {0x01E00, 75, 2, 1}, {0x01E9B, 1, 1, -58},
+            {0x01E9E, 1, 1, -7615}, {0x01EA0, 48, 2, 1}, {0x01F08, 8, 1, -8}, {0x01F18, 6, 1, -8},
+            {0x01F28, 8, 1, -8}, {0x01F38, 8, 1, -8}, {0x01F48, 6, 1, -8}, {0x01F59, 4, 2, -8}, {0x01F68, 8, 1, -8},
+            {0x01F88, 8, 1, -8}, {0x01F98, 8, 1, -8}, {0x01FA8, 8, 1, -8}, {0x01FB8, 2, 1, -8}, {0x01FBA, 2, 1, -74},
+            {0x01FBC, 1, 1, -9}, {0x01FBE, 1, 1, -7173}, {0x01FC8, 4, 1, -86}, {0x01FCC, 1, 1, -9},
+            {0x01FD8, 2, 1, -8}, {0x01FDA, 2, 1, -100}, {0x01FE8, 2, 1, -8}, {0x01FEA, 2, 1, -112},
+            {0x01FEC, 1, 1, -7}, {0x01FF8, 2, 1, -128}, {0x01FFA, 2, 1, -126}, {0x01FFC, 1, 1, -9},
+            {0x02126, 1, 1, -7517}, {0x0212A, 1, 1, -8383}, {0x0212B, 1, 1, -8262}, {0x02132, 1, 1, 28},
+            {0x02160, 16, 1, 16}, {0x02183, 1, 1, 1}, {0x024B6, 26, 1, 26}, {0x02C00, 48, 1, 48}, {0x02C60, 1, 1, 1},
+            {0x02C62, 1, 1, -10743}, {0x02C63, 1, 1, -3814}, {0x02C64, 1, 1, -10727}, {0x02C67, 3, 2, 1},
+            {0x02C6D, 1, 1, -10780}, {0x02C6E, 1, 1, -10749}, {0x02C6F, 1, 1, -10783}, {0x02C70, 1, 1, -10782},
+            {0x02C72, 1, 1, 1}, {0x02C75, 1, 1, 1}, {0x02C7E, 2, 1, -10815}, {0x02C80, 50, 2, 1}, {0x02CEB, 2, 2, 1},
+            {0x02CF2, 1, 1, 1}, {0x0A640, 23, 2, 1}, {0x0A680, 14, 2, 1}, {0x0A722, 7, 2, 1}, {0x0A732, 31, 2, 1},
+            {0x0A779, 2, 2, 1}, {0x0A77D, 1, 1, -35332}, {0x0A77E, 5, 2, 1}, {0x0A78B, 1, 1, 1},
+            {0x0A78D, 1, 1, -42280}, {0x0A790, 2, 2, 1}, {0x0A796, 10, 2, 1}, {0x0A7AA, 1, 1, -42308},
+            {0x0A7AB, 1, 1, -42319}, {0x0A7AC, 1, 1, -42315}, {0x0A7AD, 1, 1, -42305}, {0x0A7AE, 1, 1, -42308},
+            {0x0A7B0, 1, 1, -42258}, {0x0A7B1, 1, 1, -42282}, {0x0A7B2, 1, 1, -42261}, {0x0A7B3, 1, 1, 928},
+            {0x0A7B4, 8, 2, 1}, {0x0A7C4, 1, 1, -48}, {0x0A7C5, 1, 1, -42307}, {0x0A7C6, 1, 1, -35384},
+            {0x0A7C7, 2, 2, 1}, {0x0A7D0, 1, 1, 1}, {0x0A7D6, 2, 2, 1}, {0x0A7F5, 1, 1, 1}, {0x0AB70, 80, 1, -38864},
+            {0x0FF21, 26, 1, 32}, {0x10400, 40, 1, 40}, {0x104B0, 36, 1, 40}, {0x10570, 11, 1, 39},
+            {0x1057C, 15, 1, 39}, {0x1058C, 7, 1, 39}, {0x10594, 2, 1, 39}, {0x10C80, 51, 1, 64},
+            {0x118A0, 32, 1, 32}, {0x16E40, 32, 1, 32}, {0x1E900, 34, 1, 34}
+        };
+
+        inline constexpr u32 fold_lookup(u32 cp) noexcept
+        {
+            u64 lo = 0, hi = std::size(fold_ranges);
+            while (lo < hi)
+            {
+                const u64 mid = (lo + hi) / 2;
+                if (cp < fold_ranges[mid].first)
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            if (!lo)
+                return cp;
+            const fold_range& range = fold_ranges[lo - 1];
+            const u32 offset = cp - range.first;
+            if (offset % range.stride || offset / range.stride >= range.count)
+                return cp;
+            return static_cast<u32>(static_cast<i64>(cp) + range.delta);
+        }
+
+        // Direct table for the two-byte range, which covers Latin, Greek, Cyrillic, Armenian and Hebrew scripts
+        inline constexpr u64 fold_direct_size = 0x800;
+
+        inline constexpr auto fold_direct = []()
+        {
+            std::array<u16, fold_direct_size> result{};
+            for (u32 cp = 0; cp < fold_direct_size; ++cp)
+                result[cp] = static_cast<u16>(fold_lookup(cp));
+            return result;
+        }();
+    }
+    // namespace detail
+
+    inline namespace unicode
+    {
+        // Whether s is well-formed UTF-8: no overlong forms, surrogates, code points above U+10FFFF or truncated
+        // sequences
+        inline bool utf8_validate(span<const char> s) noexcept
+        {
+#ifdef UF_SIMD_X86
+            if (simd::active() >= simd::level::avx2)
+                return detail::utf8_validate_avx2(s.data(), s.size());
+#endif
+            return detail::utf8_validate_scalar(s.data(), s.size());
+        }
+
+        inline char32_t casefold(char32_t cp) noexcept
+        {
+            if (cp < detail::fold_direct_size)
+                return detail::fold_direct[cp];
+            return static_cast<char32_t>(detail::fold_lookup(static_cast<u32>(cp)));
+        }
+
+        // Simple case folding of UTF-8 text for case-insensitive keys. ASCII runs are lowercased with the vector
+        // kernels, other code points go through the folding table. Invalid bytes are copied as they are.
+        inline std::string casefold(std::string_view s)
+        {
+            std::string result(s.size() + s.size() / 2 + 4, '\0');
+            char* out = result.data();
+            for (u64 i = 0; i < s.size();)
+            {
+                const u64 ascii = detail::ascii_prefix(s.data() + i, s.size() - i);
+                detail::ascii_flip_case(s.data() + i, out, ascii, 'A');
+                out += ascii;
+                i += ascii;
+                // Non-ASCII runs are handled here without going back to the vector scan for every code point
+                while (i < s.size() && static_cast<u8>(s[i]) >= 0x80)
+                {
+                    u32 cp;
+                    if (const u64 length = detail::utf8_decode(s.data() + i, s.size() - i, cp))
+                    {
+                        out += detail::utf8_encode(casefold(static_cast<char32_t>(cp)), out);
+                        i += length;
+                    }
+                    else
+                        *out++ = s[i++];
+                }
+            }
+            result.resize(out - result.data());
+            return result;
+        }
+    }
+    // inline namespace unicode
+}
+// namespace uf
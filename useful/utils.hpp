@@ -44,6 +44,96 @@ namespace uf
         {
             return std::make_tuple(std::get<Ns>(std::forward<T>(t))...);
         }
+
+        // Packs of at least this many values of one integral type are compiled into a lookup set
+        inline constexpr u64 literal_set_threshold = 8;
+
+        template<typename... Ps>
+        struct is_literal_pack : std::false_type { };
+
+        template<typename P, typename... Ps>
+        struct is_literal_pack<P, Ps...> : std::bool_constant<sizeof...(Ps) + 1 >= literal_set_threshold &&
+                                                              std::is_integral_v<std::decay_t<P>> && !std::is_same_v<std::decay_t<P>, bool> &&
+                                                              (std::is_same_v<std::decay_t<P>, std::decay_t<Ps>> && ...)> { };
+
+        template<typename Tp, u64 N>
+        class literal_set_base
+        {
+        protected:
+            std::array<Tp, N> m_values;
+
+        public:
+            constexpr literal_set_base(const std::array<Tp, N>& values) : m_values(values) { }
+
+            // Elements of another type keep the exact semantics of operator==
+            template<typename E>
+            constexpr bool contains_any(const E& e) const
+            {
+                for (const auto& v : m_values)
+                    if (e == v)
+                        return true;
+                return false;
+            }
+        };
+
+        template<typename Tp, u64 N>
+        class bitmap_literal_set : public literal_set_base<Tp, N>
+        {
+            u64 m_bits[4]{};
+
+        public:
+            constexpr bitmap_literal_set(const std::array<Tp, N>& values) : literal_set_base<Tp, N>(values)
+            {
+                for (const auto& v : values)
+                {
+                    const u8 b = static_cast<u8>(v);
+                    m_bits[b >> 6] |= u64(1) << (b & 63);
+                }
+            }
+
+            template<typename E>
+            constexpr bool contains(const E& e) const
+            {
+                if constexpr (std::is_same_v<E, Tp>)
+                {
+                    const u8 b = static_cast<u8>(e);
+                    return m_bits[b >> 6] >> (b & 63) & 1;
+                }
+                else
+                    return this->contains_any(e);
+            }
+        };
+
+        template<typename Tp, u64 N>
+        class sorted_literal_set : public literal_set_base<Tp, N>
+        {
+        public:
+            sorted_literal_set(const std::array<Tp, N>& values) : literal_set_base<Tp, N>(values)
+            {
+                std::sort(this->m_values.begin(), this->m_values.end());
+            }
+
+            template<typename E>
+            bool contains(const E& e) const
+            {
+                if constexpr (std::is_same_v<E, Tp>)
+                {
+                    // Branchless lower bound, the trip count only depends on N
+                    const Tp* base = this->m_values.data();
+                    for (u64 size = N; size > 1; size -= size / 2)
+                        base = base[size / 2] < e ? base + size / 2 : base;
+                    base += *base < e;
+                    return base != this->m_values.data() + N && *base == e;
+                }
+                else
+                    return this->contains_any(e);
+            }
+        };
+
+        // Both sets live inside the predicate and are built without touching the heap, so making a predicate per
+        // call of split and friends stays cheap
+        template<typename Tp, u64 N>
+        using literal_set = std::conditional_t<sizeof(Tp) == 1, bitmap_literal_set<Tp, N>, sorted_literal_set<Tp, N>>;
     }
     // namespace detail
 
@@ -85,7 +175,13 @@ namespace uf
         template<class... Ps>
         constexpr auto stf_any_obj(Ps&&... ps)
         {
-            return [ps...](const auto& e) mutable { return stf_any(e, ps...); }; // TODO: forward capture
+            if constexpr (detail::is_literal_pack<Ps...>::value)
+            {
+                using value_type = std::decay_t<mt::tpack_first_t<Ps...>>;
+                return [set = detail::literal_set<value_type, sizeof...(Ps)>(std::array<value_type, sizeof...(Ps)>{{ps...}})](const auto& e) { return set.contains(e); };
+            }
+            else
+                return [ps...](const auto& e) mutable { return stf_any(e, ps...); }; // TODO: forward capture
         }
 
         template<class... Ps>
@@ -149,9 +245,10 @@ namespace uf
         template<class Associative, class... Rs>
         void remove_associative(Associative& c, Rs&&... rs)
         {
+            auto fobject = stf_any_obj(std::forward<Rs>(rs)...);
             for (auto i = c.begin(); i != c.end();)
             {
-                if (stf_any(*i, rs...))
+                if (fobject(*i))
                     i = c.erase(i);
                 else
                     ++i;
@@ -162,8 +259,9 @@ namespace uf
         Associative remove_associative_copy(const Associative& c, Rs&&... rs)
         {
             Associative result;
+            auto fobject = stf_any_obj(std::forward<Rs>(rs)...);
             for (auto i = c.begin(); i != c.end(); ++i)
-                if (!stf_any(*i, rs...))
+                if (!fobject(*i))
                     result.insert(*i);
             return result;
         }
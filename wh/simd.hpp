@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <algorithm>
+
+#include "base.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define WH_SIMD_X86
+#define WH_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace wh::simd
+{
+    // Instruction set levels in increasing order, kernels are picked by the highest active one
+    enum class level : u8
+    {
+        scalar,
+        sse2,
+        avx2,
+        avx512
+    };
+
+    namespace detail
+    {
+        inline level detect_level() noexcept
+        {
+#ifdef WH_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+                return level::avx512;
+            if (__builtin_cpu_supports("avx2"))
+                return level::avx2;
+            if (__builtin_cpu_supports("sse2"))
+                return level::sse2;
+#endif
+            return level::scalar;
+        }
+
+        inline std::atomic<level>& active_level() noexcept
+        {
+            static std::atomic<level> result(detect_level());
+            return result;
+        }
+    }
+    // namespace detail
+
+    inline level supported() noexcept
+    {
+        static const level result = detail::detect_level();
+        return result;
+    }
+
+    inline level active() noexcept
+    {
+        return detail::active_level().load(std::memory_order_relaxed);
+    }
+
+    // Caps dispatch at the given level (never above what the CPU supports), useful for tests and benchmarks
+    inline void limit(level l) noexcept
+    {
+        detail::active_level().store(std::min(l, supported()), std::memory_order_relaxed);
+    }
+}
+// namespace wh::simd
@@ -1,50 +1,135 @@
 #pragma once
 #include "utils.hpp"
+#include "span.hpp"
+#include "simd.hpp"
 
 namespace wh
 {
-    namespace detail
+    inline namespace strings
     {
+        namespace detail
+        {
+            // Flips the case of every byte in [lo, lo + 25], 'A' gives lowercase and 'a' gives uppercase
+            inline void ascii_flip_case_scalar(const char* src, char* dst, u64 n, char lo) noexcept
+            {
+                for (u64 i = 0; i < n; ++i)
+                    dst[i] = static_cast<u8>(src[i] - lo) < 26 ? src[i] ^ 0x20 : src[i];
+            }
 
-    }
-    // namespace detail
+#ifdef WH_SIMD_X86
+            WH_TARGET("sse2") inline u64 ascii_flip_case_sse2(const char* src, char* dst, u64 n, char lo) noexcept
+            {
+                // Shift the range to [-128, -103] so that one signed compare selects it
+                const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80 - lo));
+                const __m128i bound = _mm_set1_epi8(-128 + 26);
+                const __m128i flip = _mm_set1_epi8(0x20);
+                u64 i = 0;
+                for (; i + 16 <= n; i += 16)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                    const __m128i mask = _mm_cmpgt_epi8(bound, _mm_add_epi8(v, bias));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(v, _mm_and_si128(mask, flip)));
+                }
+                return i;
+            }
 
-    inline namespace strings
-    {
+            WH_TARGET("avx2") inline u64 ascii_flip_case_avx2(const char* src, char* dst, u64 n, char lo) noexcept
+            {
+                const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80 - lo));
+                const __m256i bound = _mm256_set1_epi8(-128 + 26);
+                const __m256i flip = _mm256_set1_epi8(0x20);
+                u64 i = 0;
+                for (; i + 32 <= n; i += 32)
+                {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                    const __m256i mask = _mm256_cmpgt_epi8(bound, _mm256_add_epi8(v, bias));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(v, _mm256_and_si256(mask, flip)));
+                }
+                return i;
+            }
+
+            WH_TARGET("avx512f,avx512bw") inline u64 ascii_flip_case_avx512(const char* src, char* dst, u64 n, char lo) noexcept
+            {
+                const __m512i low = _mm512_set1_epi8(lo);
+                const __m512i range = _mm512_set1_epi8(26);
+                const __m512i flip = _mm512_set1_epi8(0x20);
+                for (u64 i = 0; i < n; i += 64)
+                {
+                    // Masked load and store handle the tail, so no scalar remainder is left
+                    const __mmask64 active = n - i >= 64 ? ~__mmask64(0) : (__mmask64(1) << (n - i)) - 1;
+                    const __m512i v = _mm512_maskz_loadu_epi8(active, src + i);
+                    const __mmask64 letters = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(v, low), range);
+                    _mm512_mask_storeu_epi8(dst + i, active, _mm512_mask_blend_epi8(letters, v, _mm512_xor_si512(v, flip)));
+                }
+                return n;
+            }
+#endif
+
+            inline void ascii_flip_case(const char* src, char* dst, u64 n, char lo) noexcept
+            {
+                u64 done = 0;
+#ifdef WH_SIMD_X86
+                switch (simd::active())
+                {
+                case simd::level::avx512:
+                    done = ascii_flip_case_avx512(src, dst, n, lo);
+                    break;
+                case simd::level::avx2:
+                    done = ascii_flip_case_avx2(src, dst, n, lo);
+                    break;
+                case simd::level::sse2:
+                    done = ascii_flip_case_sse2(src, dst, n, lo);
+                    break;
+                case simd::level::scalar:
+                    break;
+                }
+#endif
+                ascii_flip_case_scalar(src + done, dst + done, n - done, lo);
+            }
+        }
+        // namespace detail
+
+        // ASCII only: bytes outside 'A'-'Z' / 'a'-'z' (including UTF-8 sequences) are left untouched
         inline std::string lowercase(const std::string& s)
         {
-            std::string result;
-            result.reserve(s.size());
-            for (auto c : s)
-                result.push_back(std::tolower(c));
+            std::string result(s.size(), '\0');
+            detail::ascii_flip_case(s.data(), result.data(), s.size(), 'A');
             return result;
         }
 
         inline std::string lowercase(std::string&& s)
         {
             std::string result(std::move(s));
-            for (auto& c : result)
-                c = std::tolower(c);
+            detail::ascii_flip_case(result.data(), result.data(), result.size(), 'A');
             return result;
         }
 
+        template<typename Tp, enif<std::is_same_v<Tp, char>> = SF>
+        void lowercase(span<Tp> s) noexcept
+        {
+            detail::ascii_flip_case(s.data(), s.data(), s.size(), 'A');
+        }
+
         inline std::string uppercase(const std::string& s)
         {
-            std::string result;
-            result.reserve(s.size());
-            for (auto c : s)
-                result.push_back(std::toupper(c));
+            std::string result(s.size(), '\0');
+            detail::ascii_flip_case(s.data(), result.data(), s.size(), 'a');
             return result;
         }
 
         inline std::string uppercase(std::string&& s)
         {
             std::string result(std::move(s));
-            for (auto& c : result)
-                c = std::toupper(c);
+            detail::ascii_flip_case(result.data(), result.data(), result.size(), 'a');
             return result;
         }
 
+        template<typename Tp, enif<std::is_same_v<Tp, char>> = SF>
+        void uppercase(span<Tp> s) noexcept
+        {
+            detail::ascii_flip_case(s.data(), s.data(), s.size(), 'a');
+        }
+
         template<class SeqContainer, typename... Ps>
         auto lstrip(const SeqContainer& c, Ps&&... ps)
         {